@@ -2,9 +2,34 @@
 #include <string>
 #include <vector>
 #include <stack>
+#include <deque>
+#include <climits>
+#include <cerrno>
 #include <queue>
 #include <list>
+#include <algorithm>
 #include <functional> // For priority queue comparison
+#include <type_traits>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 
@@ -13,55 +38,627 @@ using namespace std;
 // ==========================================
 
 enum class ItemType { FOOD, HERB, TOOL, KEY_ITEM };
+const int ITEM_TYPE_COUNT = 4;
 enum class Role { HUNTER, SCOUT, GUARD, NONE };
 
 // Represents the state of the game loop
 enum class GameState { START_SCREEN, PLAYING, EVENT_TRIGGERED, GAMEOVER, VICTORY };
 
+// Read-only view of a whole file. Memory-mapped where the OS supports it,
+// otherwise read into a buffer with a single read.
+class MappedFile {
+private:
+    const uint8_t* bytes = nullptr;
+    size_t length = 0;
+    vector<uint8_t> fallback;
+    bool mapped = false;
+
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { close(); }
+
+    bool open(const string& path) {
+        close();
+#if defined(__unix__) || defined(__APPLE__)
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* p = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                bytes = static_cast<const uint8_t*>(p);
+                length = size_t(st.st_size);
+                mapped = true;
+            }
+        }
+        ::close(fd);
+        return mapped;
+#else
+        FILE* f = fopen(path.c_str(), "rb");
+        if (!f) return false;
+        fseek(f, 0, SEEK_END);
+        long n = ftell(f);
+        fseek(f, 0, SEEK_SET);
+        if (n > 0) {
+            fallback.resize(size_t(n));
+            if (fread(fallback.data(), 1, fallback.size(), f) == fallback.size()) {
+                bytes = fallback.data();
+                length = fallback.size();
+            }
+        }
+        fclose(f);
+        return bytes != nullptr;
+#endif
+    }
+
+    void close() {
+#if defined(__unix__) || defined(__APPLE__)
+        if (mapped) munmap(const_cast<uint8_t*>(bytes), length);
+#endif
+        mapped = false;
+        bytes = nullptr;
+        length = 0;
+        fallback.clear();
+    }
+
+    const uint8_t* data() const { return bytes; }
+    size_t size() const { return length; }
+};
+
+#ifdef WOLF_COUNT_ALLOCATIONS
+// Test builds: count every heap allocation so a check can assert that a
+// game turn makes none it could avoid.
+//     AllocationScope scope;  /* play one turn */  assert(scope.count() == 0);
+inline atomic<size_t>& allocationCount() {
+    static atomic<size_t> count{0};
+    return count;
+}
+
+[[gnu::noinline]] void* operator new(size_t size) {
+    allocationCount().fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+[[gnu::noinline]] void operator delete(void* p) noexcept { free(p); }
+[[gnu::noinline]] void operator delete(void* p, size_t) noexcept { free(p); }
+
+struct AllocationScope {
+    size_t start = allocationCount().load();
+    size_t count() const { return allocationCount().load() - start; }
+};
+#endif
+
+// Deterministic random numbers (xoshiro256**). Each world seeds its own
+// generator, so a run can be replayed exactly from its seed. jump()
+// advances by 2^128 draws, which splits one seed into non-overlapping
+// streams for parallel simulations.
+class WorldRng {
+private:
+    uint64_t state[4];
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+public:
+    WorldRng() { seed(0x5EED); }
+    explicit WorldRng(uint64_t seedValue) { seed(seedValue); }
+
+    void seed(uint64_t seedValue) {
+        uint64_t z = seedValue; // expand with splitmix64 so no state is all-zero
+        for (uint64_t& word : state) {
+            z += 0x9E3779B97F4A7C15ull;
+            uint64_t x = z;
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+            word = x ^ (x >> 31);
+        }
+    }
+
+    uint64_t next() {
+        uint64_t result = rotl(state[1] * 5, 7) * 9;
+        uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    // Uniform in [0, bound) without modulo bias (Lemire's method)
+    uint32_t below(uint32_t bound) {
+        uint64_t m = (next() >> 32) * bound;
+        if (uint32_t(m) < bound) {
+            uint32_t threshold = uint32_t(-bound) % bound;
+            while (uint32_t(m) < threshold) m = (next() >> 32) * bound;
+        }
+        return uint32_t(m >> 32);
+    }
+
+    // Uniform in [0, 1)
+    double unit() { return (next() >> 11) * 0x1.0p-53; }
+
+    void jump() {
+        static const uint64_t JUMP[] = {0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull,
+                                        0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull};
+        uint64_t s[4] = {0, 0, 0, 0};
+        for (uint64_t mask : JUMP) {
+            for (int bit = 0; bit < 64; bit++) {
+                if (mask & (1ull << bit))
+                    for (int i = 0; i < 4; i++) s[i] ^= state[i];
+                next();
+            }
+        }
+        for (int i = 0; i < 4; i++) state[i] = s[i];
+    }
+
+    // Raw state, for save files
+    void getState(uint64_t out[4]) const { memcpy(out, state, sizeof(state)); }
+    void setState(const uint64_t in[4]) { memcpy(state, in, sizeof(state)); }
+
+    // Independent stream number `index` of a seed
+    static WorldRng stream(uint64_t seedValue, uint32_t index) {
+        WorldRng rng(seedValue);
+        for (uint32_t i = 0; i < index; i++) rng.jump();
+        return rng;
+    }
+};
+
+// Copy-on-write holder. Copies share one block until one of them calls
+// write(), which clones the block if anyone else still holds it, so
+// taking a snapshot of a large structure is O(1). A default-constructed
+// holder allocates nothing until its first write.
+template <typename T>
+class CowPtr {
+private:
+    shared_ptr<T> block; // null means a default-constructed T
+
+    static const T& emptyValue() {
+        static const T empty{};
+        return empty;
+    }
+
+public:
+    const T& read() const { return block ? *block : emptyValue(); }
+    T& write() {
+        if (!block) block = make_shared<T>();
+        else if (block.use_count() > 1) block = make_shared<T>(*block);
+        // Pairs with the release in another thread's shared_ptr drop, so its
+        // reads of the block finish before we modify it in place
+        atomic_thread_fence(memory_order_acquire);
+        return *block;
+    }
+    bool sharesWith(const CowPtr& other) const { return block == other.block; }
+};
+
+// Copy-on-write array in pages of about PAGE_BYTES each (a power-of-two
+// element count), each page a CowPtr. Copying the array copies one pointer
+// per page, and a write clones only the page it lands in, so a snapshot of
+// n elements costs O(n / page size) and each later change copies at most
+// one page, not the whole array. A page grows like a vector up to its full
+// size, so a small array (a fresh pack, a short event queue) holds only
+// what it uses. Elements are read with [] and changed with write(i); take
+// a reference into a page only after the last write() before using it, or
+// copy the value (a write may move this array to a cloned page).
+// Elements past size() are kept, so shrinking and regrowing does not allocate.
+template <typename T, size_t PAGE_BYTES = 4096>
+class PagedVector {
+private:
+    static constexpr size_t pageBits() {
+        size_t bits = 0;
+        while ((size_t(2) << bits) * sizeof(T) <= PAGE_BYTES) bits++;
+        return bits;
+    }
+
+public:
+    static constexpr size_t PAGE_BITS = pageBits();
+    static constexpr size_t PAGE_SIZE = size_t(1) << PAGE_BITS;
+
+private:
+    struct Page {
+        unique_ptr<T[]> items;
+        size_t used = 0;     // elements written, including any past size()
+        size_t capacity = 0; // at most PAGE_SIZE
+
+        Page() = default;
+        // A cloned page is sized to what is used
+        Page(const Page& other) : items(new T[other.used]), used(other.used), capacity(other.used) {
+            copy(other.items.get(), other.items.get() + used, items.get());
+        }
+        Page& operator=(const Page&) = delete;
+
+        void grow() {
+            size_t bigger = min(PAGE_SIZE, max<size_t>(capacity * 2, 4));
+            unique_ptr<T[]> moved(new T[bigger]);
+            move(items.get(), items.get() + used, moved.get());
+            items.swap(moved);
+            capacity = bigger;
+        }
+    };
+    vector<CowPtr<Page>> pages; // all but the last are full
+    size_t count = 0;
+
+public:
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    const T& operator[](size_t i) const { return pages[i >> PAGE_BITS].read().items[i & (PAGE_SIZE - 1)]; }
+    const T& front() const { return (*this)[0]; }
+    const T& back() const { return (*this)[count - 1]; }
+    T& write(size_t i) { return pages[i >> PAGE_BITS].write().items[i & (PAGE_SIZE - 1)]; }
+
+    void push_back(T value) {
+        size_t slot = count & (PAGE_SIZE - 1);
+        if (count >> PAGE_BITS == pages.size()) pages.emplace_back();
+        Page& page = pages[count >> PAGE_BITS].write();
+        if (slot == page.used) {
+            if (page.used == page.capacity) page.grow();
+            page.used++;
+        }
+        page.items[slot] = move(value);
+        ++count;
+    }
+    void pop_back() { --count; }
+    void resize(size_t n) {
+        while (count < n) push_back(T());
+        count = n;
+    }
+    void reserve(size_t n) { pages.reserve((n + PAGE_SIZE - 1) >> PAGE_BITS); }
+    void clear() {
+        pages.clear();
+        count = 0;
+    }
+
+    // Visits elements in order, a page of contiguous memory at a time
+    template <typename Visit>
+    void forEach(Visit visit) const {
+        for (size_t p = 0; p * PAGE_SIZE < count; p++) {
+            const T* items = pages[p].read().items.get();
+            size_t n = min(PAGE_SIZE, count - p * PAGE_SIZE);
+            for (size_t i = 0; i < n; i++) visit(items[i]);
+        }
+    }
+};
+
+// Handle to a string stored once in the global StringInterner
+using TextId = uint32_t;
+const TextId NO_TEXT = 0xFFFFFFFFu; // reads as ""
+
+// Stores each distinct text once. Scenario, choice, item and event texts
+// repeat a lot ("Fight", "Flee", ...), so structs keep a 4-byte TextId
+// instead of their own std::string. Text lives in fixed chunks that never
+// move, so views returned by view() stay valid for the interner's lifetime.
+// The id -> text table is paged and never moves either, so another thread
+// (e.g. the autosave writer) may call view() on ids it was handed through
+// a lock while this thread keeps interning. Holds up to 2^24 texts.
+class StringInterner {
+private:
+    static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+    vector<unique_ptr<char[]>> chunks;
+    char* chunk = nullptr;           // chunk small texts are appended to
+    size_t chunkUsed = CHUNK_SIZE;   // forces a chunk on first intern
+    static constexpr size_t PAGE_BITS = 12;
+    static constexpr size_t PAGE_SIZE = size_t(1) << PAGE_BITS;
+    static constexpr size_t MAX_PAGES = 4096;
+
+    unique_ptr<unique_ptr<string_view[]>[]> pages{new unique_ptr<string_view[]>[MAX_PAGES]}; // TextId -> text
+    atomic<uint32_t> textCount{0};
+    vector<TextId> table;            // open addressing, NO_TEXT = empty slot
+    uint64_t requestedBytes = 0;     // every byte ever passed to intern()
+    uint64_t storedBytes = 0;        // bytes actually kept
+
+    static uint64_t hashText(string_view s) {
+        uint64_t h = 1469598103934665603ull; // FNV-1a
+        for (char c : s) {
+            h ^= static_cast<uint8_t>(c);
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    size_t probe(string_view s) const {
+        size_t mask = table.size() - 1;
+        size_t i = hashText(s) & mask;
+        while (table[i] != NO_TEXT && textAt(table[i]) != s) i = (i + 1) & mask;
+        return i;
+    }
+
+    string_view textAt(TextId id) const { return pages[id >> PAGE_BITS][id & (PAGE_SIZE - 1)]; }
+
+    void grow() {
+        vector<TextId> old(table.empty() ? 1024 : table.size() * 2, NO_TEXT);
+        old.swap(table);
+        for (TextId id = 0; id < count(); id++) table[probe(textAt(id))] = id;
+    }
+
+    const char* store(string_view s) {
+        if (s.size() > CHUNK_SIZE / 4) { // large texts get their own chunk
+            chunks.emplace_back(new char[s.size()]);
+            memcpy(chunks.back().get(), s.data(), s.size());
+            return chunks.back().get();
+        }
+        if (chunkUsed + s.size() > CHUNK_SIZE) {
+            chunks.emplace_back(new char[CHUNK_SIZE]);
+            chunk = chunks.back().get();
+            chunkUsed = 0;
+        }
+        char* dst = chunk + chunkUsed;
+        memcpy(dst, s.data(), s.size());
+        chunkUsed += s.size();
+        return dst;
+    }
+
+public:
+    StringInterner() = default;
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+    TextId intern(string_view s) {
+        requestedBytes += s.size();
+        if ((count() + 1) * 2 > table.size()) grow();
+        size_t slot = probe(s);
+        if (table[slot] == NO_TEXT) {
+            TextId id = static_cast<TextId>(count());
+            if (id >= PAGE_SIZE * MAX_PAGES) return NO_TEXT;
+            unique_ptr<string_view[]>& page = pages[id >> PAGE_BITS];
+            if (!page) page.reset(new string_view[PAGE_SIZE]);
+            page[id & (PAGE_SIZE - 1)] = string_view(store(s), s.size());
+            textCount.store(id + 1, memory_order_release);
+            table[slot] = id;
+            storedBytes += s.size();
+        }
+        return table[slot];
+    }
+
+    // NO_TEXT when s was never interned; never stores anything
+    TextId find(string_view s) const {
+        if (table.empty()) return NO_TEXT;
+        return table[probe(s)];
+    }
+
+    string_view view(TextId id) const {
+        return id < textCount.load(memory_order_acquire) ? textAt(id) : string_view();
+    }
+
+    // Memory report: bytes kept vs. bytes that separate strings would need
+    size_t count() const { return textCount.load(memory_order_relaxed); }
+    uint64_t bytesStored() const { return storedBytes; }
+    uint64_t bytesSaved() const { return requestedBytes - storedBytes; }
+};
+
+// Interner the current thread uses instead of the global one, if any (see
+// InternerScope)
+inline StringInterner*& boundInterner() {
+    thread_local StringInterner* bound = nullptr;
+    return bound;
+}
+
+inline StringInterner& interner() {
+    static StringInterner instance;
+    StringInterner* bound = boundInterner();
+    return bound ? *bound : instance;
+}
+
+// Makes this thread use `own` for all TextIds while in scope, so engines
+// on different threads never share (and contend on) one interner. TextIds
+// are then only meaningful on threads bound to the same interner: a
+// GameEngine (and anything else holding TextIds) must stay on the thread
+// it was built on, and text crossing threads must travel as strings.
+class InternerScope {
+private:
+    StringInterner* previous;
+
+public:
+    explicit InternerScope(StringInterner& own) : previous(boundInterner()) { boundInterner() = &own; }
+    ~InternerScope() { boundInterner() = previous; }
+    InternerScope(const InternerScope&) = delete;
+    InternerScope& operator=(const InternerScope&) = delete;
+};
+
+inline string_view textOf(TextId id) { return interner().view(id); }
+
 // ==========================================
-// MODULE 2: CHARACTER & INVENTORY (Linked List)
+// MODULE 2: CHARACTER, INVENTORY & PACK
 // ==========================================
 
-// 1. Data Structure: Singly Linked List Node for Inventory
+// 1. Data Structure: Inventory Item (stored inline in Inventory)
 struct ItemNode {
-    string name;
+    TextId name;        // interned, read with textOf()
     ItemType type;
     int effectValue; // e.g., +20 Health or -10 Hunger
-    string description;
-    
-    ItemNode* next; // Pointer to next item
+    TextId description; // interned, read with textOf()
 
-    ItemNode(string n, ItemType t, int v, string d) 
-        : name(n), type(t), effectValue(v), description(d), next(nullptr) {}
+    ItemNode() : name(NO_TEXT), type(ItemType::FOOD), effectValue(0), description(NO_TEXT) {}
+    ItemNode(string_view n, ItemType t, int v, string_view d) 
+        : name(interner().intern(n)), type(t), effectValue(v), description(interner().intern(d)) {}
 };
 
+// Items are identified by their interned name, so lookups compare integers
+using ItemId = TextId;
+
 // 2. Class: Inventory System
+// Fixed-capacity array held inside the object: the inventory never has
+// more than MAX_ITEMS entries, so adding and removing never touch the heap.
 class Inventory {
+public:
+    static constexpr int MAX_ITEMS = 10;
+
 private:
-    ItemNode* head;
+    ItemNode items[MAX_ITEMS]; // items[0..itemCount) in insertion order
+    ItemId itemIds[MAX_ITEMS]; // items[i].name, packed for the lookup scan
     int itemCount;
-    const int MAX_ITEMS = 10;
+
+    // Closes the gap so iteration order stays insertion order
+    void removeAt(int slot) {
+        for (int i = slot; i + 1 < itemCount; i++) {
+            items[i] = items[i + 1];
+            itemIds[i] = itemIds[i + 1];
+        }
+        --itemCount;
+    }
 
 public:
-    Inventory();
-    ~Inventory(); // Destructor to clean up memory
+    Inventory() : itemCount(0) {}
+
+    // Id for a name without interning it; NO_TEXT if no item was ever called that
+    static ItemId itemId(string_view name) { return interner().find(name); }
+
+    // Slot of the first item with this id, or -1
+    int findSlot(ItemId id) const {
+        for (int i = 0; i < itemCount; i++)
+            if (itemIds[i] == id) return i;
+        return -1;
+    }
+
+    bool addItem(string_view name, ItemType type, int value, string_view desc) {
+        if (isFull()) return false;
+        items[itemCount] = ItemNode(name, type, value, desc);
+        itemIds[itemCount] = items[itemCount].name;
+        ++itemCount;
+        return true;
+    }
+
+    // Hot paths: integer compares only
+    bool useItem(ItemId id, class Wolf* player); // Forward declaration of Wolf needed
+    void removeItem(ItemId id) {
+        int slot = findSlot(id);
+        if (slot >= 0) removeAt(slot);
+    }
+
+    // By-name wrappers
+    bool useItem(string_view itemName, class Wolf* player) { return useItem(itemId(itemName), player); }
+    void removeItem(string_view itemName) { removeItem(itemId(itemName)); }
 
-    bool addItem(string name, ItemType type, int value, string desc);
-    bool useItem(string itemName, class Wolf* player); // Forward declaration of Wolf needed
-    void removeItem(string itemName);
     void displayInventory();
-    bool isFull();
-    
-    // For Save/Load
-    ItemNode* getHead() const { return head; }
+    bool isFull() { return itemCount >= MAX_ITEMS; }
+
+    // Same items in the same order (undo history uses this to skip unchanged inventories)
+    bool operator==(const Inventory& other) const {
+        if (itemCount != other.itemCount) return false;
+        for (int i = 0; i < itemCount; i++) {
+            const ItemNode& a = items[i];
+            const ItemNode& b = other.items[i];
+            if (a.name != b.name || a.type != b.type || a.effectValue != b.effectValue ||
+                a.description != b.description)
+                return false;
+        }
+        return true;
+    }
+    bool operator!=(const Inventory& other) const { return !(*this == other); }
+
+    // Iteration for Save/Load and the GUI: for (const ItemNode& item : inventory)
+    const ItemNode* begin() const { return items; }
+    const ItemNode* end() const { return items + itemCount; }
+    int size() const { return itemCount; }
 };
 
-// 3. Class: Pack Member (Linked List Node)
+// 3. Struct: Pack Member (one row of PackRoster)
 struct PackMember {
-    string name;
+    TextId name; // interned, read with textOf()
     Role role;
     int loyalty;
-    PackMember* next;
+};
+
+const int ROLE_COUNT = 4; // HUNTER, SCOUT, GUARD, NONE
+
+// 3b. Class: Pack Roster (struct-of-arrays)
+// Names, roles and loyalty live in parallel arrays, and each Role keeps
+// a bucket of member indices plus a running loyalty total. Per-role
+// counts and totals are O(1), "weakest of a role" scans only that
+// bucket, and whole-pack loyalty scans run over contiguous int pages.
+// Dismissal swaps the last member into the gap, so a member's index is
+// only stable until the next dismissal. The arrays are PagedVectors, so
+// copying a roster (see Wolf::pack) shares its pages and a change after
+// a snapshot copies only the few pages it touches.
+class PackRoster {
+private:
+    PagedVector<TextId> names;
+    PagedVector<Role> roles;
+    PagedVector<int> loyalty;
+    PagedVector<uint32_t> bucketPos;          // member -> position in its role bucket
+    PagedVector<uint32_t> buckets[ROLE_COUNT]; // role -> member indices
+    int loyaltyTotal[ROLE_COUNT] = {};
+
+    static int slot(Role role) { return static_cast<int>(role); }
+
+public:
+    int add(string_view name, Role role, int loyaltyValue) {
+        uint32_t index = static_cast<uint32_t>(names.size());
+        names.push_back(interner().intern(name));
+        roles.push_back(role);
+        loyalty.push_back(loyaltyValue);
+        bucketPos.push_back(static_cast<uint32_t>(buckets[slot(role)].size()));
+        buckets[slot(role)].push_back(index);
+        loyaltyTotal[slot(role)] += loyaltyValue;
+        return static_cast<int>(index);
+    }
+
+    void removeAt(int index) {
+        // Drop from its role bucket
+        Role role = roles[index];
+        PagedVector<uint32_t>& bucket = buckets[slot(role)];
+        uint32_t moved = bucket.back();
+        uint32_t gap = bucketPos[index];
+        bucket.write(gap) = moved;
+        bucketPos.write(moved) = gap;
+        bucket.pop_back();
+        loyaltyTotal[slot(role)] -= loyalty[index];
+
+        // Move the last member into the gap
+        uint32_t last = static_cast<uint32_t>(names.size() - 1);
+        if (uint32_t(index) != last) {
+            TextId lastName = names[last];
+            Role lastRole = roles[last];
+            int lastLoyalty = loyalty[last];
+            uint32_t lastPos = bucketPos[last];
+            names.write(index) = lastName;
+            roles.write(index) = lastRole;
+            loyalty.write(index) = lastLoyalty;
+            bucketPos.write(index) = lastPos;
+            buckets[slot(lastRole)].write(lastPos) = uint32_t(index);
+        }
+        names.pop_back();
+        roles.pop_back();
+        loyalty.pop_back();
+        bucketPos.pop_back();
+    }
+
+    // Removes the first member with this name; false if none
+    bool remove(TextId name) {
+        for (size_t i = 0; i < names.size(); i++) {
+            if (names[i] == name) {
+                removeAt(static_cast<int>(i));
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void setLoyalty(int index, int value) {
+        loyaltyTotal[slot(roles[index])] += value - loyalty[index];
+        loyalty.write(index) = value;
+    }
+
+    int size() const { return static_cast<int>(names.size()); }
+    PackMember member(int index) const { return PackMember{names[index], roles[index], loyalty[index]}; }
+    const PagedVector<int>& loyalties() const { return loyalty; }
+
+    // Role queries
+    int countOf(Role role) const { return static_cast<int>(buckets[slot(role)].size()); }
+    int totalLoyalty(Role role) const { return loyaltyTotal[slot(role)]; }
+    const PagedVector<uint32_t>& membersWith(Role role) const { return buckets[slot(role)]; }
+
+    // Index of the least loyal member with this role, or -1
+    int weakest(Role role) const {
+        int best = -1;
+        buckets[slot(role)].forEach([&](uint32_t i) {
+            if (best < 0 || loyalty[i] < loyalty[best]) best = static_cast<int>(i);
+        });
+        return best;
+    }
 };
 
 // 4. Class: The Player (Wolf)
@@ -73,8 +670,8 @@ public:
     int energy;   // 0-100
     int reputation; // 0-100
 
-    Inventory inventory;
-    PackMember* packHead; // Head of the pack linked list
+    Inventory inventory;    // small fixed-size value, cheap to copy
+    CowPtr<PackRoster> pack; // pack.read() to query, pack.write() to change
 
     Wolf();
     
@@ -86,7 +683,8 @@ public:
     void takeDamage(int amount);
     
     // Pack Mechanics
-    void recruitMember(string name, Role role);
+    void recruitMember(string_view name, Role role);
+    bool dismissMember(string_view name) { return pack.write().remove(interner().find(name)); }
     void displayPack();
 };
 
@@ -95,50 +693,638 @@ public:
 // ==========================================
 
 // 5. Data Structure: Binary Tree Node
+// Texts are interned TextIds; read them with textOf().
 struct StoryNode {
     int id;
-    string scenarioText;
+    TextId scenarioText;
     
     // Choice Texts
-    string choiceAText;
-    string choiceBText;
+    TextId choiceAText;
+    TextId choiceBText;
 
     // Pointers to consequences/next scenarios
     StoryNode* left;  // Path A
     StoryNode* right; // Path B
 
     bool isEnding;
-    string endingDescription;
+    TextId endingDescription;
+
+    StoryNode(int _id, string_view text) 
+        : id(_id), scenarioText(interner().intern(text)), choiceAText(NO_TEXT), choiceBText(NO_TEXT),
+          left(nullptr), right(nullptr), isEnding(false), endingDescription(NO_TEXT) {}
+};
+
+// Read-only view of the current story node, whichever storage holds it.
+// Texts point straight into the node's storage (the interner, or the
+// arena / mapped story file) and stay valid until the story changes.
+struct StoryView {
+    int id;
+    string_view scenario, choiceA, choiceB, ending;
+    bool isEnding;
+    bool hasLeft, hasRight; // whether moveToLeft()/moveToRight() go anywhere
+};
+
+// 5b. Data Structure: Open-Addressing Hash Table (id -> value)
+// Flat array with linear probing. Capacity is kept a power of two and
+// at most half full, so a lookup is one hash plus a short probe run.
+template <typename T>
+class IdIndex {
+private:
+    struct Slot {
+        int key;
+        T value;
+        bool used;
+    };
+    vector<Slot> slots;
+    size_t count = 0;
+
+    static size_t hashId(int id) {
+        uint32_t x = static_cast<uint32_t>(id) * 0x9E3779B1u; // Fibonacci hashing
+        return x ^ (x >> 16);
+    }
+
+    size_t probe(int key) const {
+        size_t mask = slots.size() - 1;
+        size_t i = hashId(key) & mask;
+        while (slots[i].used && slots[i].key != key) i = (i + 1) & mask;
+        return i;
+    }
+
+public:
+    void reserve(size_t n) {
+        size_t cap = 16;
+        while (cap < n * 2) cap <<= 1;
+        if (cap <= slots.size()) return;
+
+        vector<Slot> old;
+        old.swap(slots);
+        slots.assign(cap, Slot{0, T(), false});
+        count = 0;
+        for (const Slot& s : old)
+            if (s.used) insert(s.key, s.value);
+    }
+
+    void insert(int key, T value) {
+        if ((count + 1) * 2 > slots.size()) reserve(count + 1);
+        size_t i = probe(key);
+        if (!slots[i].used) {
+            slots[i].used = true;
+            slots[i].key = key;
+            ++count;
+        }
+        slots[i].value = value;
+    }
+
+    const T* find(int key) const {
+        if (slots.empty()) return nullptr;
+        size_t i = probe(key);
+        return slots[i].used ? &slots[i].value : nullptr;
+    }
+
+    void clear() { slots.clear(); count = 0; }
+    size_t size() const { return count; }
+};
+
+// 5c. Data Structure: Contiguous Story Arena (struct-of-arrays)
+// Every node lives in one block, one column per field, with 32-bit child
+// indices instead of pointers. Build is a single allocation when the node
+// count is reserved up front, and teardown is a single free.
+const uint32_t NO_NODE = 0xFFFFFFFFu;
+
+enum StoryText { TEXT_SCENARIO, TEXT_CHOICE_A, TEXT_CHOICE_B, TEXT_ENDING, TEXT_FIELDS };
+
+// Compiled story file (.wstory): this header, then the arena columns exactly
+// as StoryArena lays them out for nodeCount nodes, then the text blob.
+// Header and columns are in the writing machine's byte order and are used
+// in place, so a file only loads on a machine of the same endianness;
+// compile with compileStoryFile().
+const char STORY_FILE_MAGIC[4] = {'W', 'S', 'T', 'Y'};
+const uint32_t STORY_FILE_VERSION = 1;
+
+struct StoryFileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t nodeCount;
+    uint32_t rootIndex;
+    uint64_t textBytes;
+};
+
+class StoryArena {
+private:
+    unique_ptr<uint32_t[]> block; // all columns below point into this
+    uint32_t capacity = 0;
+    uint32_t count = 0;
+
+    uint32_t* textOffset = nullptr; // TEXT_FIELDS entries per node
+    uint32_t* textLength = nullptr; // TEXT_FIELDS entries per node
+    uint32_t* ids = nullptr;
+    uint32_t* leftIdx = nullptr;
+    uint32_t* rightIdx = nullptr;
+    uint8_t* endingFlags = nullptr;
+
+    string textPool; // all node texts back to back
+
+    // Dedup table over textPool, so repeats are stored once. Open addressing
+    // on (offset, length) ranges compared as string_views: a lookup builds
+    // no string, and the text lives only in textPool.
+    struct PooledText {
+        uint32_t offset;
+        uint32_t length; // NO_NODE = empty slot
+    };
+    vector<PooledText> pooled;
+    uint32_t pooledCount = 0;
+
+    // Set when the columns and text point into a loaded story file
+    const char* fileText = nullptr;
+
+    static size_t wordsFor(uint32_t n) {
+        return size_t(n) * (2 * TEXT_FIELDS + 3) + (size_t(n) + 3) / 4;
+    }
+
+    void layout(uint32_t* base, uint32_t n) {
+        textOffset = base;
+        textLength = textOffset + size_t(n) * TEXT_FIELDS;
+        ids = textLength + size_t(n) * TEXT_FIELDS;
+        leftIdx = ids + n;
+        rightIdx = leftIdx + n;
+        endingFlags = reinterpret_cast<uint8_t*>(rightIdx + n);
+    }
+
+    static size_t hashText(string_view s) {
+        uint64_t h = 1469598103934665603ull; // FNV-1a
+        for (char c : s) {
+            h ^= static_cast<uint8_t>(c);
+            h *= 1099511628211ull;
+        }
+        return static_cast<size_t>(h);
+    }
+
+    size_t probePooled(string_view text) const {
+        size_t mask = pooled.size() - 1;
+        size_t i = hashText(text) & mask;
+        while (pooled[i].length != NO_NODE &&
+               string_view(textPool.data() + pooled[i].offset, pooled[i].length) != text)
+            i = (i + 1) & mask;
+        return i;
+    }
+
+    void growPooled() {
+        vector<PooledText> old(pooled.empty() ? 256 : pooled.size() * 2, PooledText{0, NO_NODE});
+        old.swap(pooled);
+        for (const PooledText& p : old)
+            if (p.length != NO_NODE) pooled[probePooled(string_view(textPool.data() + p.offset, p.length))] = p;
+    }
+
+    void setText(uint32_t node, StoryText field, string_view text) {
+        if ((pooledCount + 1) * 2 > pooled.size()) growPooled();
+        size_t slot = probePooled(text);
+        if (pooled[slot].length == NO_NODE) {
+            pooled[slot] = PooledText{static_cast<uint32_t>(textPool.size()), static_cast<uint32_t>(text.size())};
+            pooledCount++;
+            textPool.append(text);
+        }
+        textOffset[node * TEXT_FIELDS + field] = pooled[slot].offset;
+        textLength[node * TEXT_FIELDS + field] = static_cast<uint32_t>(text.size());
+    }
+
+    // Moves the columns into a fresh block sized for exactly n nodes
+    void relayout(uint32_t n) {
+        unique_ptr<uint32_t[]> bigger(new uint32_t[wordsFor(n)]());
+        uint32_t* oldOffset = textOffset;
+        uint32_t* oldLength = textLength;
+        uint32_t* oldIds = ids;
+        uint32_t* oldLeft = leftIdx;
+        uint32_t* oldRight = rightIdx;
+        uint8_t* oldFlags = endingFlags;
+
+        layout(bigger.get(), n);
+        for (uint32_t i = 0; i < count * TEXT_FIELDS; i++) {
+            textOffset[i] = oldOffset[i];
+            textLength[i] = oldLength[i];
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            ids[i] = oldIds[i];
+            leftIdx[i] = oldLeft[i];
+            rightIdx[i] = oldRight[i];
+            endingFlags[i] = oldFlags[i];
+        }
+        block.swap(bigger);
+        capacity = n;
+    }
+
+public:
+    // Grows the block to hold n nodes, keeping existing nodes.
+    void reserve(uint32_t n) {
+        if (n > capacity && !fileText) relayout(n);
+    }
+
+    // Nodes cannot be added to an arena attached to a story file.
+    uint32_t addNode(int id, string_view scenario) {
+        if (fileText) return NO_NODE;
+        if (count == capacity) reserve(capacity ? capacity * 2 : 64);
+        uint32_t node = count++;
+        ids[node] = static_cast<uint32_t>(id);
+        leftIdx[node] = NO_NODE;
+        rightIdx[node] = NO_NODE;
+        endingFlags[node] = 0;
+        setText(node, TEXT_SCENARIO, scenario);
+        setText(node, TEXT_CHOICE_A, "");
+        setText(node, TEXT_CHOICE_B, "");
+        setText(node, TEXT_ENDING, "");
+        return node;
+    }
+
+    // The setters below do nothing on an arena attached to a story file
+    // (its columns are a read-only mapping).
+    void setChoices(uint32_t node, string_view a, string_view b) {
+        if (fileText) return;
+        setText(node, TEXT_CHOICE_A, a);
+        setText(node, TEXT_CHOICE_B, b);
+    }
+
+    void setEnding(uint32_t node, string_view description) {
+        if (fileText) return;
+        endingFlags[node] = 1;
+        setText(node, TEXT_ENDING, description);
+    }
+
+    void link(uint32_t parent, uint32_t left, uint32_t right) {
+        if (fileText) return;
+        leftIdx[parent] = left;
+        rightIdx[parent] = right;
+    }
+
+    void clear() {
+        block.reset();
+        textPool.clear();
+        textPool.shrink_to_fit();
+        pooled.clear();
+        pooledCount = 0;
+        fileText = nullptr;
+        capacity = count = 0;
+        layout(nullptr, 0);
+    }
+
+    // Points the arena at a compiled story image without copying it. The
+    // image must outlive the arena (or the next clear()). Every child index
+    // and text range is checked once here, so a corrupt file is rejected
+    // instead of being read out of bounds later.
+    bool attach(const uint8_t* image, size_t size, uint32_t* rootIndex) {
+        StoryFileHeader header;
+        if (!image || size < sizeof(header)) return false;
+        memcpy(&header, image, sizeof(header));
+        if (memcmp(header.magic, STORY_FILE_MAGIC, 4) != 0 || header.version != STORY_FILE_VERSION)
+            return false;
+        uint32_t n = header.nodeCount;
+        size_t columnBytes = wordsFor(n) * sizeof(uint32_t);
+        if (size - sizeof(header) < columnBytes || size - sizeof(header) - columnBytes < header.textBytes)
+            return false;
+        if (n > 0 && header.rootIndex >= n) return false;
 
-    StoryNode(int _id, string text) 
-        : id(_id), scenarioText(text), left(nullptr), right(nullptr), isEnding(false) {}
+        StoryArena view;
+        view.layout(reinterpret_cast<uint32_t*>(const_cast<uint8_t*>(image + sizeof(header))), n);
+        for (uint32_t i = 0; i < n; i++) {
+            if ((view.leftIdx[i] >= n && view.leftIdx[i] != NO_NODE) ||
+                (view.rightIdx[i] >= n && view.rightIdx[i] != NO_NODE))
+                return false;
+        }
+        for (size_t i = 0; i < size_t(n) * TEXT_FIELDS; i++) {
+            if (uint64_t(view.textOffset[i]) + view.textLength[i] > header.textBytes) return false;
+        }
+
+        clear();
+        layout(view.textOffset, n);
+        fileText = reinterpret_cast<const char*>(image + sizeof(header) + columnBytes);
+        capacity = count = n;
+        *rootIndex = header.rootIndex;
+        return true;
+    }
+
+    // Writes the arena in story file format with one buffered write
+    bool writeFile(const string& path, uint32_t rootIndex) {
+        if (fileText) return false;
+        if (capacity != count) relayout(count);
+
+        StoryFileHeader header;
+        memcpy(header.magic, STORY_FILE_MAGIC, 4);
+        header.version = STORY_FILE_VERSION;
+        header.nodeCount = count;
+        header.rootIndex = rootIndex;
+        header.textBytes = textPool.size();
+
+        size_t columnBytes = wordsFor(count) * sizeof(uint32_t);
+        vector<char> image(sizeof(header) + columnBytes + textPool.size());
+        memcpy(image.data(), &header, sizeof(header));
+        if (columnBytes) memcpy(image.data() + sizeof(header), block.get(), columnBytes);
+        memcpy(image.data() + sizeof(header) + columnBytes, textPool.data(), textPool.size());
+
+        FILE* f = fopen(path.c_str(), "wb");
+        if (!f) return false;
+        bool ok = fwrite(image.data(), 1, image.size(), f) == image.size();
+        return fclose(f) == 0 && ok;
+    }
+
+    uint32_t size() const { return count; }
+    int id(uint32_t node) const { return static_cast<int>(ids[node]); }
+    bool isEnding(uint32_t node) const { return endingFlags[node] != 0; }
+    uint32_t left(uint32_t node) const { return leftIdx[node]; }
+    uint32_t right(uint32_t node) const { return rightIdx[node]; }
+
+    // View into the text pool; invalidated by the next add/set call.
+    string_view text(uint32_t node, StoryText field) const {
+        size_t i = size_t(node) * TEXT_FIELDS + field;
+        const char* base = fileText ? fileText : textPool.data();
+        return string_view(base + textOffset[i], textLength[i]);
+    }
 };
 
+// Offline compiler: story source text -> .wstory file. Source format, one
+// node per "@node" block, the first node being the start of the story:
+//
+//     @node 1
+//     scenario: A storm rolls over the valley.
+//     a: Shelter in the cave -> 2
+//     b: Push on through the rain -> 3
+//     @node 3
+//     scenario: The river has flooded.
+//     ending: You are swept away.
+//
+// Returns false on I/O errors, malformed lines, duplicate ids or links to
+// unknown ids.
+inline bool compileStoryFile(const string& sourcePath, const string& outPath) {
+    struct SourceNode {
+        int id;
+        string scenario, choiceA, choiceB, ending;
+        int leftId = 0, rightId = 0;
+        bool hasLeft = false, hasRight = false; // ids may be negative, so no sentinel id
+        bool isEnding = false;
+    };
+
+    // Whole-string decimal int, no exceptions
+    auto parseId = [](const string& text, int& id) {
+        const char* begin = text.c_str();
+        char* end = nullptr;
+        errno = 0;
+        long value = strtol(begin, &end, 10);
+        if (end == begin || *end != '\0' || errno == ERANGE || value < INT_MIN || value > INT_MAX) return false;
+        id = int(value);
+        return true;
+    };
+
+    ifstream in(sourcePath);
+    if (!in) return false;
+
+    vector<SourceNode> nodes;
+    string line;
+    while (getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+        if (line.compare(0, 6, "@node ") == 0) {
+            SourceNode n;
+            if (!parseId(line.substr(6), n.id)) return false;
+            nodes.push_back(n);
+            continue;
+        }
+        size_t colon = line.find(':');
+        if (nodes.empty() || colon == string::npos) return false;
+        string key = line.substr(0, colon);
+        string value = line.substr(colon + 1);
+        if (!value.empty() && value[0] == ' ') value.erase(0, 1);
+
+        SourceNode& n = nodes.back();
+        if (key == "scenario") {
+            n.scenario = value;
+        } else if (key == "ending") {
+            n.isEnding = true;
+            n.ending = value;
+        } else if (key == "a" || key == "b") {
+            size_t arrow = value.rfind(" -> ");
+            if (arrow == string::npos) return false;
+            int target;
+            if (!parseId(value.substr(arrow + 4), target)) return false;
+            value.resize(arrow);
+            if (key == "a") { n.choiceA = value; n.leftId = target; n.hasLeft = true; }
+            else { n.choiceB = value; n.rightId = target; n.hasRight = true; }
+        } else {
+            return false;
+        }
+    }
+    if (nodes.empty()) return false;
+
+    StoryArena arena;
+    IdIndex<uint32_t> slots;
+    arena.reserve(static_cast<uint32_t>(nodes.size()));
+    for (const SourceNode& n : nodes) {
+        if (slots.find(n.id)) return false;
+        uint32_t slot = arena.addNode(n.id, n.scenario);
+        arena.setChoices(slot, n.choiceA, n.choiceB);
+        if (n.isEnding) arena.setEnding(slot, n.ending);
+        slots.insert(n.id, slot);
+    }
+    for (uint32_t i = 0; i < nodes.size(); i++) {
+        const uint32_t* l = nodes[i].hasLeft ? slots.find(nodes[i].leftId) : nullptr;
+        const uint32_t* r = nodes[i].hasRight ? slots.find(nodes[i].rightId) : nullptr;
+        if ((nodes[i].hasLeft && !l) || (nodes[i].hasRight && !r)) return false;
+        arena.link(i, l ? *l : NO_NODE, r ? *r : NO_NODE);
+    }
+    return arena.writeFile(outPath, 0);
+}
+
+// Where a StoryTree keeps its nodes
+enum class StoryStorage { LINKED, ARENA };
+
 // 6. Class: Decision Tree Manager
 class StoryTree {
 private:
     StoryNode* root;
     StoryNode* currentScenario;
 
-    // Helper for recursive deletion
-    void deleteTree(StoryNode* node);
-    // Helper for finding a node by ID (for loading games)
-    StoryNode* findNode(StoryNode* node, int id);
+    // id -> node, filled as nodes are created (or rebuilt on a lookup miss)
+    IdIndex<StoryNode*> nodeIndex;
+
+    // ARENA storage: nodes live in arena and are addressed by index
+    StoryStorage storage;
+    StoryArena arena;
+    IdIndex<uint32_t> arenaIndex; // id -> arena slot
+    uint32_t currentIndex = NO_NODE;
+    StoryNode cursor{0, ""};      // copy of the current arena node for getCurrentNode()
+    StoryNode cursorLeft{0, ""};  // its children, one level deep
+    StoryNode cursorRight{0, ""};
+
+    // Points a getCurrentNode() copy at arena node i (NO_NODE gives null)
+    StoryNode* fillCursor(StoryNode& node, uint32_t i) {
+        if (i == NO_NODE) return nullptr;
+        node.id = arena.id(i);
+        node.isEnding = arena.isEnding(i);
+        node.scenarioText = interner().intern(arena.text(i, TEXT_SCENARIO));
+        node.choiceAText = interner().intern(arena.text(i, TEXT_CHOICE_A));
+        node.choiceBText = interner().intern(arena.text(i, TEXT_CHOICE_B));
+        node.endingDescription = interner().intern(arena.text(i, TEXT_ENDING));
+        return &node;
+    }
+
+    // Compiled story the arena is attached to, if any. Shared so several
+    // trees can navigate one mapping.
+    shared_ptr<const MappedFile> storyFile;
+
+    // arenaIndex is built on first lookup for file-backed stories, so
+    // opening a story costs no per-node work.
+    void ensureArenaIndex() {
+        if (arenaIndex.size() == arena.size()) return;
+        arenaIndex.reserve(arena.size());
+        for (uint32_t i = 0; i < arena.size(); i++) arenaIndex.insert(arena.id(i), i);
+    }
+
+    // Helper for deletion. Uses an explicit stack, so even a story shaped
+    // like a long chain is freed without deep recursion.
+    void deleteTree(StoryNode* node) {
+        forEachNode(node, [](StoryNode* n) { delete n; });
+    }
+    // Re-indexes the LINKED tree from root. Nodes linked in without going
+    // through createNode() are missing from nodeIndex, so a lookup miss
+    // calls this once before giving up; after it every node is O(1) again.
+    void rebuildNodeIndex() {
+        nodeIndex.clear();
+        forEachNode(root, [this](StoryNode* n) { nodeIndex.insert(n->id, n); });
+    }
+
+    // Pre-order walk of the subtree under node with an explicit stack.
+    // visit(StoryNode*) may return false to stop early (a void visitor
+    // always continues). Children are read before visit runs, so the
+    // visitor may delete the node it is given.
+    template <typename Visit>
+    static void forEachNode(StoryNode* node, Visit visit) {
+        vector<StoryNode*> pending;
+        if (node) pending.push_back(node);
+        while (!pending.empty()) {
+            StoryNode* n = pending.back();
+            pending.pop_back();
+            if (n->right) pending.push_back(n->right);
+            if (n->left) pending.push_back(n->left);
+            if constexpr (is_same_v<decltype(visit(n)), bool>) {
+                if (!visit(n)) return;
+            } else {
+                visit(n);
+            }
+        }
+    }
+
+    // Allocates a node and registers it in nodeIndex. buildTree() should
+    // create nodes through this; any it does not are found by
+    // rebuildNodeIndex() on the first lookup that misses.
+    StoryNode* createNode(int id, string_view text) {
+        StoryNode* node = new StoryNode(id, text);
+        nodeIndex.insert(id, node);
+        return node;
+    }
+
+    // ARENA counterpart of createNode()
+    uint32_t createArenaNode(int id, string_view text) {
+        uint32_t node = arena.addNode(id, text);
+        arenaIndex.insert(id, node);
+        return node;
+    }
 
 public:
-    StoryTree();
+    StoryTree(StoryStorage mode = StoryStorage::LINKED);
     ~StoryTree();
 
-    void buildTree(); // HARDCODED logic to build the tree
+    void buildTree(); // HARDCODED logic to build the tree (into arena when storage == ARENA)
+
+    // Switches to ARENA storage backed by a compiled story file (see
+    // compileStoryFile) and moves to its first node. Nothing is copied.
+    bool loadStoryFile(shared_ptr<const MappedFile> file) {
+        uint32_t rootIndex = NO_NODE;
+        if (!file || !arena.attach(file->data(), file->size(), &rootIndex)) return false;
+        storyFile = file;
+        storage = StoryStorage::ARENA;
+        arenaIndex.clear();
+        currentIndex = rootIndex < arena.size() ? rootIndex : NO_NODE;
+        return true;
+    }
+    bool loadStoryFile(const string& path) {
+        auto file = make_shared<MappedFile>();
+        return file->open(path) && loadStoryFile(shared_ptr<const MappedFile>(file));
+    }
     
     // Navigation
-    void moveToLeft();  // Player chose A
-    void moveToRight(); // Player chose B
+    void moveToLeft() { // Player chose A
+        if (storage == StoryStorage::ARENA) {
+            if (currentIndex != NO_NODE && arena.left(currentIndex) != NO_NODE)
+                currentIndex = arena.left(currentIndex);
+        } else if (currentScenario && currentScenario->left) {
+            currentScenario = currentScenario->left;
+        }
+    }
+    void moveToRight() { // Player chose B
+        if (storage == StoryStorage::ARENA) {
+            if (currentIndex != NO_NODE && arena.right(currentIndex) != NO_NODE)
+                currentIndex = arena.right(currentIndex);
+        } else if (currentScenario && currentScenario->right) {
+            currentScenario = currentScenario->right;
+        }
+    }
     
     // Getters
-    StoryNode* getCurrentNode();
-    void setCurrentNode(int id); // Used when loading a save
-    bool isAtEnding();
+    // In ARENA mode this returns a copy of the current node. Its left/right
+    // are set exactly when the node has those children (as copies whose own
+    // children are null), so "node->left" tests work as in LINKED mode.
+    // StoryNode holds TextIds, so the copies intern their texts; prefer
+    // currentView(), which reads the arena without copying.
+    StoryNode* getCurrentNode() {
+        if (storage != StoryStorage::ARENA) return currentScenario;
+        if (!fillCursor(cursor, currentIndex)) return nullptr;
+        cursor.left = fillCursor(cursorLeft, arena.left(currentIndex));
+        cursor.right = fillCursor(cursorRight, arena.right(currentIndex));
+        return &cursor;
+    }
+
+    // The current node without copying any text; id -1 when there is none
+    StoryView currentView() const {
+        if (storage == StoryStorage::ARENA) {
+            if (currentIndex == NO_NODE) return StoryView{-1, {}, {}, {}, {}, false, false, false};
+            uint32_t i = currentIndex;
+            return StoryView{arena.id(i), arena.text(i, TEXT_SCENARIO), arena.text(i, TEXT_CHOICE_A),
+                             arena.text(i, TEXT_CHOICE_B), arena.text(i, TEXT_ENDING), arena.isEnding(i),
+                             arena.left(i) != NO_NODE, arena.right(i) != NO_NODE};
+        }
+        const StoryNode* n = currentScenario;
+        if (!n) return StoryView{-1, {}, {}, {}, {}, false, false, false};
+        return StoryView{n->id, textOf(n->scenarioText), textOf(n->choiceAText), textOf(n->choiceBText),
+                         textOf(n->endingDescription), n->isEnding, n->left != nullptr, n->right != nullptr};
+    }
+    // Used when loading a save. O(1) through nodeIndex (rebuilt from root on
+    // a miss, see rebuildNodeIndex); unknown ids are ignored.
+    void setCurrentNode(int id) {
+        if (storage == StoryStorage::ARENA) {
+            ensureArenaIndex();
+            const uint32_t* slot = arenaIndex.find(id);
+            if (slot) currentIndex = *slot;
+            return;
+        }
+        StoryNode* const* hit = nodeIndex.find(id);
+        if (!hit) {
+            rebuildNodeIndex();
+            hit = nodeIndex.find(id);
+        }
+        if (hit) currentScenario = *hit;
+    }
+    // Id of the current node without building a StoryNode (-1 if none)
+    int currentNodeId() const {
+        if (storage == StoryStorage::ARENA) return currentIndex == NO_NODE ? -1 : arena.id(currentIndex);
+        return currentScenario ? currentScenario->id : -1;
+    }
+
+    // Visits every node of a LINKED tree (see the private forEachNode).
+    // ARENA nodes are plain slots 0..size-1 and need no traversal.
+    template <typename Visit>
+    void visitNodes(Visit visit) { forEachNode(root, visit); }
+
+    bool isAtEnding() {
+        if (storage == StoryStorage::ARENA)
+            return currentIndex != NO_NODE && arena.isEnding(currentIndex);
+        return currentScenario && currentScenario->isEnding;
+    }
 };
 
 // ==========================================
@@ -147,41 +1333,1521 @@ public:
 
 // 7. Struct: Event Object
 struct GameEvent {
-    string title;
-    string description;
+    TextId title;       // interned, read with textOf()
+    TextId description; // interned, read with textOf()
     int priority; // 1 = Critical, 2 = Urgent, 3 = Normal
+    uint64_t sequence; // set by EventManager; breaks ties first-in, first-out
     
     // Comparison operator for Priority Queue (Min-Heap logic)
-    // We want smaller numbers (1) to be at the TOP of the queue
+    // We want smaller numbers (1) to be at the TOP of the queue, and among
+    // equal priorities the event added first, so the order is deterministic
     bool operator>(const GameEvent& other) const {
-        return priority > other.priority; 
+        if (priority != other.priority) return priority > other.priority;
+        return sequence > other.sequence;
     }
 };
 
-// 8. Class: Event Manager
-class EventManager {
+// Handle to a pending event, returned by EventManager::addEvent. It goes
+// stale once the event is processed or cancelled; stale handles are
+// rejected, even after the slot has been reused.
+struct EventHandle {
+    uint32_t slot;
+    uint32_t generation;
+};
+
+// 7b. Data Structure: Indexed 4-ary Min-Heap
+// Every event sits in a slot whose heap position is tracked, so a pending
+// event can be cancelled or reprioritized in O(log n) without a rebuild.
+// Four children per node keeps the tree shallow and each sibling scan
+// inside one cache line. The heap itself holds only a 64-bit sort key and
+// the slot; event payloads stay put in a side table, so sifting moves
+// integers only. All arrays are PagedVectors, so a copy of the heap (see
+// EventQueueData) shares its pages and an operation after a snapshot
+// copies only the pages on its O(log n) sift path.
+class EventHeap {
 private:
-    // STL Priority Queue: <Type, Container, Comparator>
-    priority_queue<GameEvent, vector<GameEvent>, greater<GameEvent>> eventQueue;
+    static constexpr uint32_t ARITY = 4;
+    static constexpr uint32_t NOT_QUEUED = 0xFFFFFFFFu;
 
-public:
-    void triggerRandomEvent(); // Logic to generate random events
-    void addEvent(string title, string desc, int priority);
-    void processNextEvent(Wolf* player); // Pop and execute
-    bool hasPendingEvents();
-    GameEvent peekNextEvent();
-};
+    struct Entry {
+        uint64_t key; // see sortKey()
+        uint32_t slot;
+    };
+    PagedVector<Entry> heap;
+    PagedVector<GameEvent> events;    // slot -> payload
+    PagedVector<uint32_t> position;   // slot -> index in heap, NOT_QUEUED when free
+    PagedVector<uint32_t> generation; // slot -> current generation
+    PagedVector<uint32_t> freeSlots;
 
-// ==========================================
-// MODULE 4: GAME STATE & HISTORY (Stack & Queue)
-// ==========================================
+    // Priority in the top 16 bits (biased so negatives sort first), sequence
+    // in the low 48: comparing keys gives the same order as GameEvent::operator>.
+    static uint64_t sortKey(const GameEvent& e) {
+        int p = min(max(e.priority, -32768), 32767) + 32768;
+        return (uint64_t(p) << 48) | (e.sequence & 0xFFFFFFFFFFFFull);
+    }
 
-// 9. Struct: Snapshot for Undo functionality
-struct GameSnapshot {
-    int day;
-    int health, hunger, energy;
-    int currentNodeID;
-};
+    static bool before(const Entry& a, const Entry& b) { return a.key < b.key; }
+
+    void place(uint32_t i, Entry entry) {
+        heap.write(i) = entry;
+        position.write(entry.slot) = i;
+    }
+
+    void siftUp(uint32_t i) {
+        Entry moving = heap[i];
+        while (i > 0) {
+            uint32_t parent = (i - 1) / ARITY;
+            if (!before(moving, heap[parent])) break;
+            place(i, heap[parent]);
+            i = parent;
+        }
+        place(i, moving);
+    }
+
+    void siftDown(uint32_t i) {
+        Entry moving = heap[i];
+        uint32_t n = static_cast<uint32_t>(heap.size());
+        for (;;) {
+            uint32_t first = i * ARITY + 1;
+            if (first >= n) break;
+            uint32_t best = first;
+            uint32_t last = min(first + ARITY, n);
+            for (uint32_t c = first + 1; c < last; c++)
+                if (before(heap[c], heap[best])) best = c;
+            if (!before(heap[best], moving)) break;
+            place(i, heap[best]);
+            i = best;
+        }
+        place(i, moving);
+    }
+
+    // Takes heap[i] out, returning its slot to the free list
+    void removeAt(uint32_t i) {
+        uint32_t slot = heap[i].slot;
+        position.write(slot) = NOT_QUEUED;
+        ++generation.write(slot);
+        freeSlots.push_back(slot);
+
+        uint32_t last = static_cast<uint32_t>(heap.size() - 1);
+        if (i != last) place(i, heap[last]);
+        heap.pop_back();
+        if (i < heap.size()) {
+            uint32_t moved = heap[i].slot;
+            siftUp(i);
+            siftDown(position[moved]);
+        }
+    }
+
+    const uint32_t* find(EventHandle h) const {
+        if (h.slot >= position.size() || generation[h.slot] != h.generation) return nullptr;
+        return position[h.slot] == NOT_QUEUED ? nullptr : &position[h.slot];
+    }
+
+public:
+    EventHandle push(const GameEvent& event) {
+        uint32_t slot;
+        if (freeSlots.empty()) {
+            slot = static_cast<uint32_t>(position.size());
+            position.push_back(NOT_QUEUED);
+            generation.push_back(0);
+            events.push_back(event);
+        } else {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+            events.write(slot) = event;
+        }
+        heap.push_back(Entry{sortKey(event), slot});
+        siftUp(static_cast<uint32_t>(heap.size() - 1));
+        return EventHandle{slot, generation[slot]};
+    }
+
+    // Adds count events. Large batches are appended and heapified bottom-up
+    // in O(n) instead of sifting each one in. handles may be null.
+    void pushBatch(const GameEvent* batch, size_t count, EventHandle* handles) {
+        if (count < heap.size()) { // small batch: individual sifts are cheaper
+            for (size_t i = 0; i < count; i++) {
+                EventHandle h = push(batch[i]);
+                if (handles) handles[i] = h;
+            }
+            return;
+        }
+        heap.reserve(heap.size() + count);
+        for (size_t i = 0; i < count; i++) {
+            uint32_t slot;
+            if (freeSlots.empty()) {
+                slot = static_cast<uint32_t>(position.size());
+                position.push_back(NOT_QUEUED);
+                generation.push_back(0);
+                events.push_back(batch[i]);
+            } else {
+                slot = freeSlots.back();
+                freeSlots.pop_back();
+                events.write(slot) = batch[i];
+            }
+            position.write(slot) = static_cast<uint32_t>(heap.size());
+            heap.push_back(Entry{sortKey(batch[i]), slot});
+            if (handles) handles[i] = EventHandle{slot, generation[slot]};
+        }
+        if (heap.size() > 1)
+            for (uint32_t i = static_cast<uint32_t>((heap.size() - 2) / ARITY + 1); i-- > 0;) siftDown(i);
+    }
+
+    const GameEvent& top() const { return events[heap.front().slot]; }
+
+    GameEvent pop() {
+        GameEvent event = events[heap.front().slot];
+        removeAt(0);
+        return event;
+    }
+
+    bool contains(EventHandle h) const { return find(h) != nullptr; }
+
+    bool cancel(EventHandle h) {
+        const uint32_t* pos = find(h);
+        if (!pos) return false;
+        removeAt(*pos);
+        return true;
+    }
+
+    // The new sequence puts the event behind everything already at that priority
+    bool reprioritize(EventHandle h, int priority, uint64_t sequence) {
+        const uint32_t* pos = find(h);
+        if (!pos) return false;
+        uint32_t i = *pos;
+        GameEvent& event = events.write(h.slot);
+        event.priority = priority;
+        event.sequence = sequence;
+        heap.write(i).key = sortKey(event);
+        siftUp(i);
+        siftDown(position[h.slot]);
+        return true;
+    }
+
+    size_t size() const { return heap.size(); }
+    bool empty() const { return heap.empty(); }
+
+    // Visits pending events in heap (not pop) order
+    template <typename Visit>
+    void forEach(Visit visit) const {
+        heap.forEach([&](const Entry& e) { visit(events[e.slot]); });
+    }
+};
+
+// 7c. Data Structure: Ring Buffer (FIFO)
+// Power-of-two circular array that doubles when full, paged like
+// PagedVector so copies share storage.
+template <typename T>
+class Ring {
+private:
+    PagedVector<T> buffer;
+    size_t head = 0;
+    size_t count = 0;
+
+public:
+    void push(const T& value) {
+        if (count == buffer.size()) {
+            PagedVector<T> bigger;
+            bigger.resize(buffer.empty() ? 16 : buffer.size() * 2);
+            for (size_t i = 0; i < count; i++) bigger.write(i) = buffer[(head + i) & (buffer.size() - 1)];
+            swap(buffer, bigger);
+            head = 0;
+        }
+        buffer.write((head + count) & (buffer.size() - 1)) = value;
+        ++count;
+    }
+    const T& front() const { return buffer[head]; }
+    const T& at(size_t i) const { return buffer[(head + i) & (buffer.size() - 1)]; }
+    void pop() {
+        head = (head + 1) & (buffer.size() - 1);
+        --count;
+    }
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+};
+
+const int PRIORITY_LEVELS = 3; // 1 = Critical, 2 = Urgent, 3 = Normal
+
+// 7d. Data Structure: Bucket Queue
+// One FIFO ring per priority level: push and pop are O(1), and events of
+// the same priority come out in the order they were added. Priorities
+// outside 1..3 are clamped. Cancelled or moved events leave a stale ring
+// entry behind that is skipped when it reaches the front.
+class EventBuckets {
+private:
+    struct Ticket {
+        uint32_t slot;
+        uint32_t ticket; // must match tickets[slot] to be live
+    };
+    Ring<Ticket> levels[PRIORITY_LEVELS];
+    PagedVector<GameEvent> events;    // slot -> event
+    PagedVector<uint32_t> tickets;    // slot -> ticket of its live ring entry
+    PagedVector<uint32_t> generation; // slot -> current generation
+    PagedVector<bool> queued;         // slot -> in use
+    PagedVector<uint32_t> freeSlots;
+    size_t liveCount = 0;
+
+    static int level(int priority) { return min(max(priority, 1), PRIORITY_LEVELS) - 1; }
+
+    void enqueue(uint32_t slot) {
+        levels[level(events[slot].priority)].push(Ticket{slot, ++tickets.write(slot)});
+    }
+
+    void release(uint32_t slot) {
+        ++tickets.write(slot);
+        ++generation.write(slot);
+        queued.write(slot) = false;
+        freeSlots.push_back(slot);
+        --liveCount;
+    }
+
+    bool valid(EventHandle h) const {
+        return h.slot < events.size() && queued[h.slot] && generation[h.slot] == h.generation;
+    }
+
+    // Drops stale entries and returns the ring holding the next event
+    Ring<Ticket>* firstLive() {
+        for (Ring<Ticket>& ring : levels) {
+            while (!ring.empty() && ring.front().ticket != tickets[ring.front().slot]) ring.pop();
+            if (!ring.empty()) return &ring;
+        }
+        return nullptr;
+    }
+
+public:
+    EventHandle push(const GameEvent& event) {
+        uint32_t slot;
+        if (freeSlots.empty()) {
+            slot = static_cast<uint32_t>(events.size());
+            events.push_back(event);
+            tickets.push_back(0);
+            generation.push_back(0);
+            queued.push_back(true);
+        } else {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+            events.write(slot) = event;
+            queued.write(slot) = true;
+        }
+        ++liveCount;
+        enqueue(slot);
+        return EventHandle{slot, generation[slot]};
+    }
+
+    // Looks past stale entries without removing them, so peeking never writes
+    const GameEvent& top() const {
+        for (const Ring<Ticket>& ring : levels)
+            for (size_t i = 0; i < ring.size(); i++)
+                if (ring.at(i).ticket == tickets[ring.at(i).slot]) return events[ring.at(i).slot];
+        return events.front(); // unreachable when !empty()
+    }
+
+    GameEvent pop() {
+        Ring<Ticket>* ring = firstLive();
+        uint32_t slot = ring->front().slot;
+        ring->pop();
+        release(slot);
+        return events[slot];
+    }
+
+    bool contains(EventHandle h) const { return valid(h); }
+
+    bool cancel(EventHandle h) {
+        if (!valid(h)) return false;
+        release(h.slot);
+        return true;
+    }
+
+    // Re-queues at the back of the new level, matching EventHeap
+    bool reprioritize(EventHandle h, int priority, uint64_t sequence) {
+        if (!valid(h)) return false;
+        GameEvent& event = events.write(h.slot);
+        event.priority = priority;
+        event.sequence = sequence;
+        enqueue(h.slot);
+        return true;
+    }
+
+    size_t size() const { return liveCount; }
+    bool empty() const { return liveCount == 0; }
+
+    // Visits pending events, most urgent level first, FIFO within a level
+    template <typename Visit>
+    void forEach(Visit visit) const {
+        for (const Ring<Ticket>& ring : levels)
+            for (size_t i = 0; i < ring.size(); i++)
+                if (ring.at(i).ticket == tickets[ring.at(i).slot]) visit(events[ring.at(i).slot]);
+    }
+};
+
+// 7e. Struct: Random Event Template
+// Draw weight is linear in the wolf's stats, so a starving wolf can make
+// hunting events likelier: base + hungerWeight * hunger + reputationWeight
+// * reputation, floored at zero.
+struct EventTemplate {
+    TextId title;
+    TextId description;
+    int priority;
+    double baseWeight;
+    double hungerWeight;
+    double reputationWeight;
+
+    double weight(int hunger, int reputation) const {
+        return max(0.0, baseWeight + hungerWeight * hunger + reputationWeight * reputation);
+    }
+};
+
+// 7f. Data Structure: Alias Table (Vose's method)
+// O(n) to build from a list of weights, then O(1) per weighted draw:
+// one uniform column pick and one biased coin flip.
+class AliasTable {
+private:
+    vector<double> keep;    // chance of keeping column i
+    vector<uint32_t> alias; // otherwise take this one
+    vector<uint32_t> small, large; // build scratch
+
+public:
+    // Returns false (and stays empty) if no weight is positive
+    bool build(const vector<double>& weights) {
+        size_t n = weights.size();
+        double total = 0;
+        for (double w : weights) total += w;
+        keep.assign(n, 1.0);
+        alias.resize(n);
+        if (n == 0 || !(total > 0)) {
+            keep.clear();
+            return false;
+        }
+
+        small.clear();
+        large.clear();
+        for (size_t i = 0; i < n; i++) {
+            keep[i] = weights[i] * n / total;
+            alias[i] = static_cast<uint32_t>(i);
+            (keep[i] < 1.0 ? small : large).push_back(static_cast<uint32_t>(i));
+        }
+        while (!small.empty() && !large.empty()) {
+            uint32_t s = small.back(), l = large.back();
+            small.pop_back();
+            alias[s] = l;
+            keep[l] -= 1.0 - keep[s];
+            if (keep[l] < 1.0) {
+                large.pop_back();
+                small.push_back(l);
+            }
+        }
+        for (uint32_t i : small) keep[i] = 1.0; // rounding leftovers
+        for (uint32_t i : large) keep[i] = 1.0;
+        return true;
+    }
+
+    uint32_t sample(WorldRng& rng) const {
+        uint32_t column = rng.below(static_cast<uint32_t>(keep.size()));
+        return rng.unit() < keep[column] ? column : alias[column];
+    }
+
+    bool empty() const { return keep.empty(); }
+};
+
+// How EventManager orders pending events
+enum class QueueMode {
+    HEAP,    // indexed 4-ary heap, any integer priority
+    BUCKETS  // one FIFO per priority level, O(1) push/pop
+};
+
+// 8. Class: Event Manager
+// Pending events, the sequence counter and the RNG make up the queue state,
+// which is copy-on-write so GameSnapshot can capture it in O(1). The heap
+// and buckets keep their arrays in PagedVectors, so the clone a snapshot
+// forces on the next push or pop shares all but the touched pages.
+struct EventQueueData {
+    QueueMode mode = QueueMode::HEAP;
+    EventHeap heap;       // used in HEAP mode
+    EventBuckets buckets; // used in BUCKETS mode
+    uint64_t nextSequence = 0; // stamped on every added or reprioritized event
+
+    // Every pending event, oldest sequence first (for save files)
+    vector<GameEvent> pending() const {
+        vector<GameEvent> all;
+        heap.forEach([&](const GameEvent& e) { all.push_back(e); });
+        buckets.forEach([&](const GameEvent& e) { all.push_back(e); });
+        sort(all.begin(), all.end(), [](const GameEvent& a, const GameEvent& b) { return a.sequence < b.sequence; });
+        return all;
+    }
+
+    // Re-queues a saved event with its original sequence number. Feed
+    // events oldest first (as pending() returns them).
+    void restore(const GameEvent& event) {
+        if (mode == QueueMode::BUCKETS) buckets.push(event);
+        else heap.push(event);
+        nextSequence = max(nextSequence, event.sequence + 1);
+    }
+};
+
+struct EventQueueSnapshot {
+    CowPtr<EventQueueData> queue;
+    WorldRng rng;
+};
+
+class EventManager {
+private:
+    CowPtr<EventQueueData> queue; // includes the QueueMode
+    WorldRng rng; // per-world, so runs are reproducible from the seed
+
+    // Random event table; the sampler is rebuilt only when the templates
+    // or the stats the weights depend on have changed since the last draw
+    vector<EventTemplate> eventTable;
+    vector<double> drawWeights;
+    AliasTable eventSampler;
+    bool tableDirty = true;
+    int sampledHunger = 0;
+    int sampledReputation = 0;
+
+    // Applies one popped event's consequences to the player
+    void applyEvent(const GameEvent& event, Wolf* player);
+
+    // Stamps the next sequence number and queues the event
+    EventHandle push(GameEvent event) {
+        EventQueueData& q = queue.write();
+        event.sequence = q.nextSequence++;
+        return q.mode == QueueMode::BUCKETS ? q.buckets.push(event) : q.heap.push(event);
+    }
+
+public:
+    EventManager(QueueMode queueMode = QueueMode::HEAP) {
+        if (queueMode != QueueMode::HEAP) queue.write().mode = queueMode;
+    }
+
+    EventHandle addEvent(string_view title, string_view desc, int priority) {
+        return push(GameEvent{interner().intern(title), interner().intern(desc), priority, 0});
+    }
+
+    // Batch ingestion for headless simulations. Sequence numbers are
+    // assigned here in array order; batch[i].sequence is ignored.
+    // handles, if given, receives one handle per event.
+    void addEvents(const GameEvent* batch, size_t count, EventHandle* handles = nullptr) {
+        if (queue.read().mode == QueueMode::BUCKETS) {
+            for (size_t i = 0; i < count; i++) {
+                EventHandle h = push(batch[i]);
+                if (handles) handles[i] = h;
+            }
+            return;
+        }
+        EventQueueData& q = queue.write();
+        vector<GameEvent> stamped(batch, batch + count);
+        for (GameEvent& event : stamped) event.sequence = q.nextSequence++;
+        q.heap.pushBatch(stamped.data(), count, handles);
+    }
+    void addEvents(const vector<GameEvent>& batch) { addEvents(batch.data(), batch.size()); }
+
+    // Random events come from a weighted template table
+    void addEventTemplate(string_view title, string_view desc, int priority,
+                          double baseWeight, double hungerWeight = 0, double reputationWeight = 0) {
+        eventTable.push_back(EventTemplate{interner().intern(title), interner().intern(desc), priority,
+                                           baseWeight, hungerWeight, reputationWeight});
+        tableDirty = true;
+    }
+
+    // Queues one event drawn from the table with weights for the player's
+    // current stats. false if no template has a positive weight.
+    bool triggerRandomEvent(const Wolf& player) {
+        if (tableDirty || player.hunger != sampledHunger || player.reputation != sampledReputation) {
+            drawWeights.resize(eventTable.size());
+            for (size_t i = 0; i < eventTable.size(); i++)
+                drawWeights[i] = eventTable[i].weight(player.hunger, player.reputation);
+            eventSampler.build(drawWeights);
+            sampledHunger = player.hunger;
+            sampledReputation = player.reputation;
+            tableDirty = false;
+        }
+        if (eventSampler.empty()) return false;
+        const EventTemplate& pick = eventTable[eventSampler.sample(rng)];
+        push(GameEvent{pick.title, pick.description, pick.priority, 0});
+        return true;
+    }
+
+    // The world's generator; reseed to replay a run
+    void seedRandom(uint64_t seed) { rng.seed(seed); }
+    WorldRng& random() { return rng; }
+
+    void processNextEvent(Wolf* player) { // Pop and execute
+        if (!hasPendingEvents()) return;
+        EventQueueData& q = queue.write();
+        GameEvent event = q.mode == QueueMode::BUCKETS ? q.buckets.pop() : q.heap.pop();
+        applyEvent(event, player);
+    }
+
+    // Processes up to maxEvents events in order; returns how many ran
+    size_t processUpTo(size_t maxEvents, Wolf* player) {
+        size_t done = 0;
+        for (; done < maxEvents && hasPendingEvents(); done++) processNextEvent(player);
+        return done;
+    }
+
+    // Processes every pending event whose priority is level or more urgent
+    // (1 = Critical), stopping at the first less urgent one; returns how many ran
+    size_t drainPriority(int level, Wolf* player) {
+        size_t done = 0;
+        for (; hasPendingEvents() && peekNextEvent().priority <= level; done++) processNextEvent(player);
+        return done;
+    }
+
+    bool hasPendingEvents() const {
+        const EventQueueData& q = queue.read();
+        return q.mode == QueueMode::BUCKETS ? !q.buckets.empty() : !q.heap.empty();
+    }
+    const GameEvent& peekNextEvent() const {
+        const EventQueueData& q = queue.read();
+        return q.mode == QueueMode::BUCKETS ? q.buckets.top() : q.heap.top();
+    }
+
+    // Changes to an event that has not been processed yet. Both return
+    // false if the handle is stale.
+    bool cancelEvent(EventHandle handle) {
+        EventQueueData& q = queue.write();
+        return q.mode == QueueMode::BUCKETS ? q.buckets.cancel(handle) : q.heap.cancel(handle);
+    }
+    bool reprioritizeEvent(EventHandle handle, int priority) {
+        EventQueueData& q = queue.write();
+        uint64_t sequence = q.nextSequence++;
+        return q.mode == QueueMode::BUCKETS ? q.buckets.reprioritize(handle, priority, sequence)
+                                          : q.heap.reprioritize(handle, priority, sequence);
+    }
+
+    // O(1) capture/restore of everything pending, for GameSnapshot
+    EventQueueSnapshot captureQueue() const { return EventQueueSnapshot{queue, rng}; }
+    void restoreQueue(const EventQueueSnapshot& snapshot) {
+        queue = snapshot.queue;
+        rng = snapshot.rng;
+    }
+};
+
+// 8b. Data Structure: Hierarchical Timing Wheel (events scheduled by day)
+// Four wheels of 64 slots; level L slots each span 64^L days. A timer goes
+// in the highest level where its due day and today differ, and drops one
+// level each time today reaches its slot, so scheduling is O(1) and each
+// timer is moved at most WHEEL_LEVELS times before it fires. Delays are
+// capped at 64^4 - 1 days.
+class EventTimerWheel {
+private:
+    static constexpr int WHEEL_LEVELS = 4;
+    static constexpr uint32_t WHEEL_BITS = 6;
+    static constexpr uint32_t WHEEL_SLOTS = 1u << WHEEL_BITS;
+    static constexpr uint32_t NO_TIMER = 0xFFFFFFFFu;
+
+    struct Timer {
+        GameEvent event;
+        uint32_t dueDay;
+        uint32_t order; // scheduling order, so timers due together fire in that order
+        uint32_t next;
+    };
+    struct Slot {
+        uint32_t head = NO_TIMER;
+        uint32_t tail = NO_TIMER;
+    };
+
+    PagedVector<Timer> timers;    // paged, so a snapshot of the wheel shares them
+    uint32_t freeTimers = NO_TIMER; // linked through Timer::next
+    Slot wheels[WHEEL_LEVELS][WHEEL_SLOTS];
+    uint32_t today = 0;
+    uint32_t scheduled = 0;
+    uint32_t nextOrder = 0;
+    vector<uint32_t> due;         // scratch: timers firing today
+    vector<GameEvent> dueEvents;  // scratch: their events, in order
+
+    void link(uint32_t t) {
+        uint32_t differ = timers[t].dueDay ^ today;
+        int level = 0;
+        while (level + 1 < WHEEL_LEVELS && (differ >> (WHEEL_BITS * (level + 1))) != 0) level++;
+        Slot& slot = wheels[level][(timers[t].dueDay >> (WHEEL_BITS * level)) & (WHEEL_SLOTS - 1)];
+        timers.write(t).next = NO_TIMER;
+        if (slot.tail == NO_TIMER) slot.head = t;
+        else timers.write(slot.tail).next = t;
+        slot.tail = t;
+    }
+
+    // Empties a slot, returning its first timer
+    uint32_t take(Slot& slot) {
+        uint32_t head = slot.head;
+        slot.head = slot.tail = NO_TIMER;
+        return head;
+    }
+
+    // Advances one day: cascade upper levels whose slot boundary was
+    // reached, then fire everything in today's level-0 slot
+    void tick(EventManager& events) {
+        ++today;
+        for (int level = WHEEL_LEVELS - 1; level > 0; level--) {
+            uint32_t lowerMask = (1u << (WHEEL_BITS * level)) - 1;
+            if ((today & lowerMask) != 0) continue;
+            uint32_t t = take(wheels[level][(today >> (WHEEL_BITS * level)) & (WHEEL_SLOTS - 1)]);
+            while (t != NO_TIMER) {
+                uint32_t next = timers[t].next;
+                link(t);
+                t = next;
+            }
+        }
+
+        due.clear();
+        for (uint32_t t = take(wheels[0][today & (WHEEL_SLOTS - 1)]); t != NO_TIMER; t = timers[t].next)
+            due.push_back(t);
+        if (due.empty()) return;
+        sort(due.begin(), due.end(), [this](uint32_t a, uint32_t b) { return timers[a].order < timers[b].order; });
+        dueEvents.clear();
+        for (uint32_t t : due) {
+            dueEvents.push_back(timers[t].event);
+            timers.write(t).next = freeTimers;
+            freeTimers = t;
+            --scheduled;
+        }
+        events.addEvents(dueEvents.data(), dueEvents.size());
+    }
+
+public:
+    // Queues event to enter the EventManager on day today + daysAhead
+    // (at least one day ahead).
+    void schedule(const GameEvent& event, int daysAhead) {
+        uint32_t delay = static_cast<uint32_t>(min(max(daysAhead, 1), (1 << (WHEEL_BITS * WHEEL_LEVELS)) - 1));
+        uint32_t t;
+        if (freeTimers != NO_TIMER) {
+            t = freeTimers;
+            freeTimers = timers[t].next;
+        } else {
+            t = static_cast<uint32_t>(timers.size());
+            timers.push_back(Timer());
+        }
+        Timer& timer = timers.write(t);
+        timer.event = event;
+        timer.dueDay = today + delay;
+        timer.order = nextOrder++;
+        link(t);
+        ++scheduled;
+    }
+
+    // Moves the wheel forward to day, handing every timer that came due
+    // to events. An empty wheel jumps straight there.
+    void advanceTo(int day, EventManager& events) {
+        uint32_t target = static_cast<uint32_t>(max(day, 0));
+        if (scheduled == 0 && target > today) today = target;
+        while (today < target) tick(events);
+    }
+
+    // Sets the wheel's day; only an empty wheel can be moved backwards
+    void startAt(int day) {
+        if (scheduled == 0) today = static_cast<uint32_t>(max(day, 0));
+    }
+
+    // Visits every scheduled timer as visit(event, dueDay, order), in no
+    // particular order; sort by order to reschedule them in the same order
+    template <typename Visit>
+    void forEach(Visit visit) const {
+        for (const auto& level : wheels)
+            for (const Slot& slot : level)
+                for (uint32_t t = slot.head; t != NO_TIMER; t = timers[t].next)
+                    visit(timers[t].event, static_cast<int>(timers[t].dueDay), timers[t].order);
+    }
+
+    int currentDay() const { return static_cast<int>(today); }
+    size_t size() const { return scheduled; }
+};
+
+// ==========================================
+// MODULE 4: GAME STATE & HISTORY (Stack & Queue)
+// ==========================================
+
+// 9. Struct: Snapshot for Undo functionality
+// Copying one is O(1): the inventory is a small fixed-size value and the
+// pack, pending events and scheduled events are shared copy-on-write blocks.
+// The first change to one of those after a snapshot copies its page table
+// (one pointer per 4 KiB page) and the pages the change touches, not
+// the whole structure; see PagedVector.
+struct GameSnapshot {
+    int day;
+    int health, hunger, energy;
+    int reputation;
+    int currentNodeID;
+
+    Inventory inventory;
+    CowPtr<PackRoster> pack;
+    EventQueueSnapshot events;
+    CowPtr<EventTimerWheel> scheduledEvents;
+
+    // Journal records up to here are reflected in this state (saved with
+    // it; undo does not rewind it)
+    uint64_t journalPosition;
+
+    // True when the structural parts are the same objects/values
+    bool sameStructure(const GameSnapshot& other) const {
+        return inventory == other.inventory && pack.sharesWith(other.pack) &&
+               events.queue.sharesWith(other.events.queue) && scheduledEvents.sharesWith(other.scheduledEvents);
+    }
+};
+
+// 9b. Data Structure: Bounded Undo History
+// Ring buffer of 12-byte records, each holding the difference between a
+// snapshot's stats and the one pushed before it; only the newest snapshot
+// is kept whole. Undo is O(1): subtract the newest delta. When a difference
+// does not fit a record (e.g. a jump after loading a save), the earlier
+// snapshot is stored whole as a keyframe instead. Inventory, pack and event
+// state are stored beside a record only on turns where they changed. The
+// oldest records are dropped to stay under the memory cap.
+class SnapshotHistory {
+private:
+    enum RecordKind : uint8_t { RECORD_FIRST, RECORD_DELTA, RECORD_KEYFRAME };
+
+    struct Record { // snapshot i minus snapshot i-1
+        RecordKind kind;
+        int8_t health, hunger, energy;
+        int16_t day;
+        int8_t reputation;
+        bool structural; // structures of snapshot i-1 are in `structures`
+        int32_t nodeID;
+    };
+
+    vector<Record> records; // ring, records.size() == capacity
+    size_t head = 0;        // oldest record
+    size_t count = 0;
+    deque<GameSnapshot> keyframes;  // the snapshot before each KEYFRAME record, oldest first
+    deque<GameSnapshot> structures; // the snapshot before each structural DELTA record, oldest first
+    GameSnapshot newest{};
+    size_t maxBytes;
+
+    static bool fits8(long v) { return v >= INT8_MIN && v <= INT8_MAX; }
+    static bool fits16(long v) { return v >= INT16_MIN && v <= INT16_MAX; }
+
+    size_t slot(size_t i) const { return (head + i) % records.size(); }
+
+    void dropOldest() {
+        head = slot(1);
+        --count;
+        if (count == 0) { // nothing left that the stored snapshots precede
+            keyframes.clear();
+            structures.clear();
+            return;
+        }
+        Record& oldest = records[head]; // its predecessor is gone
+        if (oldest.kind == RECORD_KEYFRAME) keyframes.pop_front();
+        if (oldest.structural) structures.pop_front();
+        oldest.kind = RECORD_FIRST;
+        oldest.structural = false;
+    }
+
+public:
+    explicit SnapshotHistory(size_t memoryCap = 64 * 1024) : maxBytes(0) { setMemoryCap(memoryCap); }
+
+    // Drops the oldest snapshots if they no longer fit
+    void setMemoryCap(size_t memoryCap) {
+        size_t capacity = max<size_t>(memoryCap / sizeof(Record), 1);
+        while (count > capacity) dropOldest();
+        vector<Record> resized(capacity);
+        for (size_t i = 0; i < count; i++) resized[i] = records[slot(i)];
+        records.swap(resized);
+        head = 0;
+        maxBytes = memoryCap;
+    }
+
+    void push(const GameSnapshot& s) {
+        // Make room first, so a full ring of one slot starts over with a
+        // FIRST record instead of storing a predecessor nobody can reach
+        if (count == records.size()) dropOldest();
+        Record r{RECORD_FIRST, 0, 0, 0, 0, 0, false, 0};
+        if (count > 0) {
+            long dHealth = long(s.health) - newest.health;
+            long dHunger = long(s.hunger) - newest.hunger;
+            long dEnergy = long(s.energy) - newest.energy;
+            long dDay = long(s.day) - newest.day;
+            long dReputation = long(s.reputation) - newest.reputation;
+            long dNode = long(s.currentNodeID) - newest.currentNodeID;
+            if (fits8(dHealth) && fits8(dHunger) && fits8(dEnergy) && fits16(dDay) && fits8(dReputation) &&
+                dNode >= INT32_MIN && dNode <= INT32_MAX) {
+                r = Record{RECORD_DELTA, int8_t(dHealth), int8_t(dHunger), int8_t(dEnergy),
+                           int16_t(dDay), int8_t(dReputation), false, int32_t(dNode)};
+                if (!s.sameStructure(newest)) {
+                    r.structural = true;
+                    structures.push_back(newest);
+                }
+            } else {
+                r.kind = RECORD_KEYFRAME;
+                keyframes.push_back(newest);
+            }
+        }
+        records[slot(count)] = r;
+        ++count;
+        newest = s;
+        while (count > 1 && bytesUsed() > maxBytes) dropOldest();
+    }
+
+    // Removes the newest snapshot into out; false when empty
+    bool pop(GameSnapshot& out) {
+        if (count == 0) return false;
+        out = newest;
+        const Record& r = records[slot(count - 1)];
+        if (r.kind == RECORD_DELTA) {
+            if (r.structural) {
+                const GameSnapshot& before = structures.back();
+                newest.inventory = before.inventory;
+                newest.pack = before.pack;
+                newest.events = before.events;
+                newest.scheduledEvents = before.scheduledEvents;
+                structures.pop_back();
+            }
+            newest.health -= r.health;
+            newest.hunger -= r.hunger;
+            newest.energy -= r.energy;
+            newest.day -= r.day;
+            newest.reputation -= r.reputation;
+            newest.currentNodeID -= r.nodeID;
+        } else if (r.kind == RECORD_KEYFRAME) {
+            newest = keyframes.back();
+            keyframes.pop_back();
+        }
+        --count;
+        return true;
+    }
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+
+    // Forgets every snapshot, keeping the memory cap
+    void clear() {
+        head = count = 0;
+        keyframes.clear();
+        structures.clear();
+        newest = GameSnapshot{};
+    }
+
+    // Live history bytes (records, keyframes and structure references; the
+    // shared blocks those reference are not counted), for memory reports
+    size_t bytesUsed() const {
+        return count * sizeof(Record) + (keyframes.size() + structures.size() + 1) * sizeof(GameSnapshot);
+    }
+};
+
+// 9c. Save File Format (.wsav)
+// Fixed little-endian header, then a payload of sections, each written as
+// varint tag, varint byte length, body. Readers skip sections they do not
+// know, so a newer writer only bumps minReaderVersion when it changes the
+// meaning of an existing section. Integers in sections are LEB128 varints
+// (signed ones zigzag-encoded); texts are varint length + bytes.
+const char SAVE_FILE_MAGIC[4] = {'W', 'S', 'A', 'V'};
+const uint16_t SAVE_FORMAT_VERSION = 1;
+const uint16_t SAVE_HEADER_SIZE = 20; // magic, version, minReaderVersion, headerSize, reserved, payloadSize, checksum
+
+enum SaveSection : uint32_t {
+    SAVE_STATS = 1,    // day, health, hunger, energy, reputation, current node id
+    SAVE_ITEMS = 2,    // count, then name, type, effectValue, description per item
+    SAVE_PACK = 3,     // count, then name, role, loyalty per member
+    SAVE_WORLD = 4,    // journal position, 4 RNG state words
+    SAVE_EVENTS = 5,   // next sequence, count, then title, description, priority, sequence per event
+    SAVE_SCHEDULED = 6 // wheel day, count, then due day, title, description, priority per timer
+};
+
+class SaveWriter {
+private:
+    vector<uint8_t> out;
+    vector<uint8_t> section; // body of the section being written
+
+public:
+    static void putVarint(vector<uint8_t>& to, uint64_t v) {
+        while (v >= 0x80) {
+            to.push_back(uint8_t(v) | 0x80);
+            v >>= 7;
+        }
+        to.push_back(uint8_t(v));
+    }
+
+    void varint(uint64_t v) { putVarint(section, v); }
+    void signedVarint(int64_t v) { varint((uint64_t(v) << 1) ^ uint64_t(v >> 63)); }
+    void text(string_view s) {
+        varint(s.size());
+        section.insert(section.end(), s.begin(), s.end());
+    }
+
+    // Appends the section built by the calls since the last endSection()
+    void endSection(SaveSection tag) {
+        putVarint(out, tag);
+        putVarint(out, section.size());
+        out.insert(out.end(), section.begin(), section.end());
+        section.clear();
+    }
+
+    const vector<uint8_t>& payload() const { return out; }
+};
+
+class SaveReader {
+private:
+    const uint8_t* pos;
+    const uint8_t* end;
+    bool failed = false;
+
+public:
+    SaveReader(const uint8_t* data, size_t size) : pos(data), end(data + size) {}
+
+    uint64_t varint() {
+        uint64_t v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (pos == end) break;
+            uint8_t b = *pos++;
+            v |= uint64_t(b & 0x7F) << shift;
+            if (!(b & 0x80)) return v;
+        }
+        failed = true;
+        return 0;
+    }
+    // A varint that must be < limit (e.g. an enum's value count)
+    uint64_t varintBelow(uint64_t limit) {
+        uint64_t v = varint();
+        if (v < limit) return v;
+        failed = true;
+        return 0;
+    }
+    int64_t signedVarint() {
+        uint64_t v = varint();
+        return int64_t(v >> 1) ^ -int64_t(v & 1);
+    }
+    string_view text() {
+        uint64_t n = varint();
+        if (n > uint64_t(end - pos)) {
+            failed = true;
+            return string_view();
+        }
+        string_view s(reinterpret_cast<const char*>(pos), size_t(n));
+        pos += n;
+        return s;
+    }
+    // Splits off the next n bytes as their own reader
+    SaveReader sub(uint64_t n) {
+        if (n > uint64_t(end - pos)) {
+            failed = true;
+            n = 0;
+        }
+        SaveReader r(pos, size_t(n));
+        pos += n;
+        return r;
+    }
+
+    uint8_t byte() {
+        if (pos == end) {
+            failed = true;
+            return 0;
+        }
+        return *pos++;
+    }
+
+    size_t remaining() const { return size_t(end - pos); }
+    bool atEnd() const { return pos == end; }
+    bool ok() const { return !failed; }
+};
+
+inline uint32_t saveChecksum(const uint8_t* data, size_t size) {
+    uint32_t h = 2166136261u; // FNV-1a
+    for (size_t i = 0; i < size; i++) {
+        h ^= data[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+inline void putLE(vector<uint8_t>& out, uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; i++) out.push_back(uint8_t(v >> (8 * i)));
+}
+
+inline uint64_t getLE(const uint8_t* p, int bytes) {
+    uint64_t v = 0;
+    for (int i = 0; i < bytes; i++) v |= uint64_t(p[i]) << (8 * i);
+    return v;
+}
+
+// Whole save file image for a snapshot
+inline vector<uint8_t> encodeSave(const GameSnapshot& s) {
+    SaveWriter w;
+    w.signedVarint(s.day);
+    w.signedVarint(s.health);
+    w.signedVarint(s.hunger);
+    w.signedVarint(s.energy);
+    w.signedVarint(s.reputation);
+    w.signedVarint(s.currentNodeID);
+    w.endSection(SAVE_STATS);
+
+    w.varint(s.inventory.size());
+    for (const ItemNode& item : s.inventory) {
+        w.text(textOf(item.name));
+        w.varint(static_cast<uint64_t>(item.type));
+        w.signedVarint(item.effectValue);
+        w.text(textOf(item.description));
+    }
+    w.endSection(SAVE_ITEMS);
+
+    const PackRoster& pack = s.pack.read();
+    w.varint(pack.size());
+    for (int i = 0; i < pack.size(); i++) {
+        PackMember m = pack.member(i);
+        w.text(textOf(m.name));
+        w.varint(static_cast<uint64_t>(m.role));
+        w.signedVarint(m.loyalty);
+    }
+    w.endSection(SAVE_PACK);
+
+    uint64_t rngState[4];
+    s.events.rng.getState(rngState);
+    w.varint(s.journalPosition);
+    for (uint64_t word : rngState) w.varint(word);
+    w.endSection(SAVE_WORLD);
+
+    const EventQueueData& queue = s.events.queue.read();
+    vector<GameEvent> pending = queue.pending();
+    w.varint(queue.nextSequence);
+    w.varint(pending.size());
+    for (const GameEvent& e : pending) {
+        w.text(textOf(e.title));
+        w.text(textOf(e.description));
+        w.signedVarint(e.priority);
+        w.varint(e.sequence);
+    }
+    w.endSection(SAVE_EVENTS);
+
+    struct Timer {
+        GameEvent event;
+        int dueDay;
+        uint32_t order;
+    };
+    vector<Timer> timers;
+    const EventTimerWheel& wheel = s.scheduledEvents.read();
+    wheel.forEach([&](const GameEvent& e, int dueDay, uint32_t order) { timers.push_back(Timer{e, dueDay, order}); });
+    sort(timers.begin(), timers.end(), [](const Timer& a, const Timer& b) { return a.order < b.order; });
+    w.signedVarint(wheel.currentDay());
+    w.varint(timers.size());
+    for (const Timer& t : timers) {
+        w.signedVarint(t.dueDay);
+        w.text(textOf(t.event.title));
+        w.text(textOf(t.event.description));
+        w.signedVarint(t.event.priority);
+    }
+    w.endSection(SAVE_SCHEDULED);
+
+    const vector<uint8_t>& payload = w.payload();
+    vector<uint8_t> image;
+    image.reserve(SAVE_HEADER_SIZE + payload.size());
+    image.insert(image.end(), SAVE_FILE_MAGIC, SAVE_FILE_MAGIC + 4);
+    putLE(image, SAVE_FORMAT_VERSION, 2);
+    putLE(image, 1, 2); // minReaderVersion
+    putLE(image, SAVE_HEADER_SIZE, 2);
+    putLE(image, 0, 2);
+    putLE(image, payload.size(), 4);
+    putLE(image, saveChecksum(payload.data(), payload.size()), 4);
+    image.insert(image.end(), payload.begin(), payload.end());
+    return image;
+}
+
+// Fills the saved parts of s from a save image, leaving the rest as given
+// (pending and scheduled events are cleared if the save has none; the
+// queue keeps its QueueMode). false (s untouched) on a bad header,
+// checksum or section.
+inline bool decodeSave(const uint8_t* data, size_t size, GameSnapshot& s) {
+    if (size < SAVE_HEADER_SIZE || memcmp(data, SAVE_FILE_MAGIC, 4) != 0) return false;
+    uint16_t minReader = uint16_t(getLE(data + 6, 2));
+    uint16_t headerSize = uint16_t(getLE(data + 8, 2));
+    uint32_t payloadSize = uint32_t(getLE(data + 12, 4));
+    uint32_t checksum = uint32_t(getLE(data + 16, 4));
+    if (minReader > SAVE_FORMAT_VERSION || headerSize < SAVE_HEADER_SIZE) return false;
+    if (size < size_t(headerSize) + payloadSize) return false;
+    const uint8_t* payload = data + headerSize;
+    if (saveChecksum(payload, payloadSize) != checksum) return false;
+
+    GameSnapshot loaded = s;
+    QueueMode mode = s.events.queue.read().mode;
+    loaded.events.queue = CowPtr<EventQueueData>();
+    if (mode != QueueMode::HEAP) loaded.events.queue.write().mode = mode;
+    loaded.scheduledEvents = CowPtr<EventTimerWheel>();
+
+    SaveReader r(payload, payloadSize);
+    while (r.ok() && !r.atEnd()) {
+        uint64_t tag = r.varint();
+        SaveReader body = r.sub(r.varint());
+        switch (tag) {
+        case SAVE_STATS:
+            loaded.day = int(body.signedVarint());
+            loaded.health = int(body.signedVarint());
+            loaded.hunger = int(body.signedVarint());
+            loaded.energy = int(body.signedVarint());
+            loaded.reputation = int(body.signedVarint());
+            loaded.currentNodeID = int(body.signedVarint());
+            break;
+        case SAVE_ITEMS: {
+            loaded.inventory = Inventory();
+            uint64_t n = body.varint();
+            for (uint64_t i = 0; i < n && body.ok(); i++) {
+                string_view name = body.text();
+                ItemType type = static_cast<ItemType>(body.varintBelow(ITEM_TYPE_COUNT));
+                int effect = int(body.signedVarint());
+                string_view description = body.text();
+                if (!body.ok()) break;
+                loaded.inventory.addItem(name, type, effect, description);
+            }
+            break;
+        }
+        case SAVE_PACK: {
+            loaded.pack = CowPtr<PackRoster>();
+            PackRoster& pack = loaded.pack.write();
+            uint64_t n = body.varint();
+            for (uint64_t i = 0; i < n && body.ok(); i++) {
+                string_view name = body.text();
+                Role role = static_cast<Role>(body.varintBelow(ROLE_COUNT));
+                int loyalty = int(body.signedVarint());
+                if (!body.ok()) break;
+                pack.add(name, role, loyalty);
+            }
+            break;
+        }
+        case SAVE_WORLD: {
+            loaded.journalPosition = body.varint();
+            uint64_t rngState[4];
+            for (uint64_t& word : rngState) word = body.varint();
+            loaded.events.rng.setState(rngState);
+            break;
+        }
+        case SAVE_EVENTS: {
+            EventQueueData& queue = loaded.events.queue.write();
+            uint64_t nextSequence = body.varint();
+            uint64_t n = body.varint();
+            for (uint64_t i = 0; i < n && body.ok(); i++) {
+                TextId title = interner().intern(body.text());
+                TextId description = interner().intern(body.text());
+                int priority = int(body.signedVarint());
+                queue.restore(GameEvent{title, description, priority, body.varint()});
+            }
+            queue.nextSequence = max(queue.nextSequence, nextSequence);
+            break;
+        }
+        case SAVE_SCHEDULED: {
+            EventTimerWheel& wheel = loaded.scheduledEvents.write();
+            wheel.startAt(int(body.signedVarint()));
+            uint64_t n = body.varint();
+            for (uint64_t i = 0; i < n && body.ok(); i++) {
+                int dueDay = int(body.signedVarint());
+                TextId title = interner().intern(body.text());
+                TextId description = interner().intern(body.text());
+                int priority = int(body.signedVarint());
+                wheel.schedule(GameEvent{title, description, priority, 0}, dueDay - wheel.currentDay());
+            }
+            break;
+        }
+        default: // written by a newer version; skip
+            break;
+        }
+        if (!body.ok()) return false;
+    }
+    if (!r.ok()) return false;
+    s = loaded;
+    return true;
+}
+
+// Writes image to "<target>.tmp", flushes it to disk and renames it over
+// target, so target is always either the old or the new file, never torn
+inline bool writeFileAtomically(const string& target, const vector<uint8_t>& image) {
+    string temp = target + ".tmp";
+    FILE* f = fopen(temp.c_str(), "wb");
+    if (!f) return false;
+    bool ok = (image.empty() || fwrite(image.data(), 1, image.size(), f) == image.size()) && fflush(f) == 0;
+#if defined(__unix__) || defined(__APPLE__)
+    ok = ok && fsync(fileno(f)) == 0;
+#endif
+    ok = fclose(f) == 0 && ok;
+    return ok && rename(temp.c_str(), target.c_str()) == 0;
+}
+
+// 9d. Class: Background Autosave Writer
+// The game thread hands over a snapshot (O(1), see GameSnapshot) and goes
+// on; a writer thread encodes it, writes it to "<path>.tmp", flushes it to
+// disk and renames it over <path>, so a crash never leaves a torn save.
+// Two buffers: one save in flight, one waiting. A new request replaces the
+// waiting one, so a slow disk costs skipped intermediate saves, never
+// frame time. Follow-up work that must wait for a save to land (cutting
+// the journal) runs in the `saved` callback, also on the writer thread.
+class AutosaveWriter {
+private:
+    string path;
+    function<void(uint64_t)> saved;  // called with the journal position of each save written
+    StringInterner* texts = nullptr; // the game thread's interner
+    thread worker;
+    mutex lock;
+    condition_variable wake;
+    GameSnapshot waiting;     // next save to write
+    bool hasWaiting = false;
+    bool writing = false;     // a save is in flight
+    bool stopping = false;
+    bool lastOk = true;
+
+    void run() {
+        InternerScope scope(*texts);
+        unique_lock<mutex> guard(lock);
+        for (;;) {
+            wake.wait(guard, [this] { return hasWaiting || stopping; });
+            if (!hasWaiting) return; // stopping with nothing left
+            GameSnapshot snapshot = waiting;
+            waiting = GameSnapshot();
+            hasWaiting = false;
+            writing = true;
+            guard.unlock();
+
+            bool ok = writeFileAtomically(path, encodeSave(snapshot));
+            uint64_t position = snapshot.journalPosition;
+            snapshot = GameSnapshot(); // drop our share of the COW blocks
+            if (ok && saved) saved(position);
+
+            guard.lock();
+            writing = false;
+            lastOk = ok;
+            wake.notify_all();
+        }
+    }
+
+public:
+    AutosaveWriter() = default;
+    AutosaveWriter(const AutosaveWriter&) = delete;
+    AutosaveWriter& operator=(const AutosaveWriter&) = delete;
+    ~AutosaveWriter() { stop(); }
+
+    // onSaved (optional) runs on the writer thread after each save lands
+    void start(const string& savePath, function<void(uint64_t)> onSaved = nullptr) {
+        stop();
+        path = savePath;
+        saved = move(onSaved);
+        texts = &interner();
+        stopping = false;
+        worker = thread(&AutosaveWriter::run, this);
+    }
+
+    // Writes what is queued, then ends the writer thread
+    void stop() {
+        if (!worker.joinable()) return;
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        worker.join();
+    }
+
+    // Never blocks on I/O. false when this replaced a save that was still
+    // waiting, i.e. the disk is not keeping up.
+    bool requestSave(const GameSnapshot& snapshot) {
+        bool replaced;
+        {
+            lock_guard<mutex> guard(lock);
+            replaced = hasWaiting;
+            waiting = snapshot;
+            hasWaiting = true;
+        }
+        wake.notify_all();
+        return !replaced;
+    }
+
+    // Blocks until nothing is waiting or in flight (e.g. before quitting)
+    void flush() {
+        unique_lock<mutex> guard(lock);
+        wake.wait(guard, [this] { return !hasWaiting && !writing; });
+    }
+
+    bool isRunning() const { return worker.joinable(); }
+    bool lastSaveOk() {
+        lock_guard<mutex> guard(lock);
+        return lastOk;
+    }
+};
+
+// 9e. Class: Write-Ahead Action Journal (.wjnl)
+// Every player decision is appended as one record: varint body length,
+// body (varint lsn, action type, then a text and/or role for the types
+// that take one), 4-byte FNV-1a checksum of the body. Records are
+// buffered and written together by commit() (group commit: one write and
+// one fsync per turn, not per action). After a crash the journal is read
+// up to the first torn or corrupt record and replayed on top of the last
+// save; records with lsn <= the save's journalPosition are already in it.
+// A journal starts empty with each session (enableJournal, loading a save)
+// and is cut back to the turns after the newest save whenever one is
+// written, so it stays small and recovery reads only what it needs.
+// A SAVE_POINT record marks where a save was taken: undo history is not
+// saved, so every save is an undo barrier, and replaying the record puts
+// the barrier in the same place.
+enum class ActionType : uint8_t { MOVE_LEFT = 1, MOVE_RIGHT, USE_ITEM, RECRUIT, PROCESS_EVENT, END_DAY, UNDO, SAVE_POINT };
+
+struct PlayerAction {
+    ActionType type;
+    TextId text = NO_TEXT;   // item (USE_ITEM) or member name (RECRUIT)
+    Role role = Role::NONE;  // RECRUIT only
+};
+
+// append() and commit() belong to the game thread. cutThrough() may also
+// run on the autosave writer thread (see GameEngine::enableAutosave), so
+// the file itself is guarded by a lock; the record buffers are not shared.
+class ActionJournal {
+private:
+    string path;
+    FILE* file = nullptr;                           // guarded by fileLock
+    mutex fileLock;
+    bool active = false;                            // open, as the game thread sees it
+    vector<uint8_t> pending;                        // records not yet committed
+    vector<uint8_t> body;                           // append() scratch, reused so a turn allocates nothing
+    static constexpr size_t COMMIT_BYTES = 64 * 1024; // commit early past this much
+
+    static bool hasText(ActionType t) { return t == ActionType::USE_ITEM || t == ActionType::RECRUIT; }
+
+    // Calls visit(lsn, action, recordStart) for each intact record of a
+    // journal image; returns the length of the intact prefix. Texts are
+    // interned only when decodeTexts is set (the calling thread's interner).
+    template <typename Visit>
+    static size_t scan(const uint8_t* data, size_t size, bool decodeTexts, Visit visit) {
+        size_t valid = 0;
+        while (valid < size) {
+            SaveReader frame(data + valid, size - valid);
+            uint64_t bodyLen = frame.varint();
+            size_t headerLen = (size - valid) - frame.remaining();
+            if (!frame.ok() || bodyLen > frame.remaining() || frame.remaining() - bodyLen < 4) break;
+            const uint8_t* bodyData = data + valid + headerLen;
+            if (getLE(bodyData + bodyLen, 4) != saveChecksum(bodyData, size_t(bodyLen))) break;
+
+            SaveReader body(bodyData, size_t(bodyLen));
+            uint64_t lsn = body.varint();
+            PlayerAction action;
+            uint8_t type = body.byte();
+            if (type < uint8_t(ActionType::MOVE_LEFT) || type > uint8_t(ActionType::SAVE_POINT)) break;
+            action.type = ActionType(type);
+            if (hasText(action.type)) {
+                string_view text = body.text();
+                if (decodeTexts) action.text = interner().intern(text);
+            }
+            if (action.type == ActionType::RECRUIT) action.role = Role(body.varintBelow(ROLE_COUNT));
+            if (!body.ok()) break;
+            visit(lsn, action, valid);
+            valid += headerLen + size_t(bodyLen) + 4;
+        }
+        return valid;
+    }
+
+    // Writes and syncs pending; fileLock must be held
+    bool writePending() {
+        if (pending.empty()) return true;
+        bool ok = file && fwrite(pending.data(), 1, pending.size(), file) == pending.size() && fflush(file) == 0;
+#if defined(__unix__) || defined(__APPLE__)
+        ok = ok && fsync(fileno(file)) == 0;
+#endif
+        pending.clear();
+        return ok;
+    }
+
+public:
+    ActionJournal() = default;
+    ActionJournal(const ActionJournal&) = delete;
+    ActionJournal& operator=(const ActionJournal&) = delete;
+    ~ActionJournal() { close(); }
+
+    // Journals to journalPath. By default it starts empty (a new session);
+    // recovery passes the valid length from read() to keep the intact
+    // records and drop a torn tail, so new records never follow it.
+    bool open(const string& journalPath, size_t keepBytes = 0) {
+        close();
+        lock_guard<mutex> guard(fileLock);
+        path = journalPath;
+        if (keepBytes == 0) {
+            file = fopen(path.c_str(), "wb");
+        } else {
+#if defined(__unix__) || defined(__APPLE__)
+            struct stat info;
+            if (stat(path.c_str(), &info) == 0 && size_t(info.st_size) > keepBytes &&
+                truncate(path.c_str(), off_t(keepBytes)) != 0)
+                return false;
+#endif
+            file = fopen(path.c_str(), "ab");
+        }
+        active = file != nullptr;
+        return active;
+    }
+
+    // Commits what is buffered, then closes the file
+    void close() {
+        lock_guard<mutex> guard(fileLock);
+        active = false;
+        if (!file) return;
+        writePending();
+        fclose(file);
+        file = nullptr;
+    }
+
+    // Empties an open journal, dropping buffered records too (the session
+    // they belong to has been replaced, e.g. by loading a save)
+    bool restart() {
+        pending.clear();
+        lock_guard<mutex> guard(fileLock);
+        if (!active) return true;
+        if (file) fclose(file);
+        file = fopen(path.c_str(), "wb");
+        return file != nullptr;
+    }
+
+    bool isOpen() const { return active; }
+
+    void append(uint64_t lsn, const PlayerAction& action) {
+        if (!active) return;
+        body.clear();
+        SaveWriter::putVarint(body, lsn);
+        body.push_back(uint8_t(action.type));
+        if (hasText(action.type)) {
+            string_view text = textOf(action.text);
+            SaveWriter::putVarint(body, text.size());
+            body.insert(body.end(), text.begin(), text.end());
+        }
+        if (action.type == ActionType::RECRUIT) SaveWriter::putVarint(body, uint64_t(action.role));
+
+        SaveWriter::putVarint(pending, body.size());
+        pending.insert(pending.end(), body.begin(), body.end());
+        putLE(pending, saveChecksum(body.data(), body.size()), 4);
+        if (pending.size() >= COMMIT_BYTES) commit();
+    }
+
+    // Makes every appended record durable. false on a write error.
+    bool commit() {
+        if (pending.empty()) return true;
+        lock_guard<mutex> guard(fileLock);
+        return writePending();
+    }
+
+    // Drops the committed records up to lsn once a save holds their effect,
+    // so the journal only ever spans the turns since the last save. The rest
+    // is rewritten atomically (see writeFileAtomically); false on an I/O
+    // error, leaving the journal whole. Records still buffered are not
+    // touched; any up to lsn are skipped by recovery and go at the next cut.
+    bool cutThrough(uint64_t lsn) {
+        lock_guard<mutex> guard(fileLock);
+        if (!file) return true;
+        vector<uint8_t> rest;
+        {
+            MappedFile current;
+            if (current.open(path)) {
+                size_t from = SIZE_MAX;
+                size_t valid = scan(current.data(), current.size(), false,
+                                    [&](uint64_t recordLsn, const PlayerAction&, size_t start) {
+                                        if (recordLsn > lsn && from == SIZE_MAX) from = start;
+                                    });
+                if (from < valid) rest.assign(current.data() + from, current.data() + valid);
+            }
+        }
+        if (!writeFileAtomically(path, rest)) return false;
+        fclose(file);
+        file = fopen(path.c_str(), "ab");
+        return file != nullptr;
+    }
+
+    // Calls visit(lsn, action) for each intact record in order, stopping at
+    // the first torn, corrupt or invalid one (bad action type or role).
+    // Returns the byte length of the intact prefix (0 if the file is missing).
+    template <typename Visit>
+    static size_t read(const string& journalPath, Visit visit) {
+        MappedFile file;
+        if (!file.open(journalPath)) return 0;
+        return scan(file.data(), file.size(), true,
+                    [&](uint64_t lsn, const PlayerAction& action, size_t) { visit(lsn, action); });
+    }
+};
 
 // 10. Class: Game Loop & History
 class GameEngine {
@@ -189,9 +2855,10 @@ private:
     Wolf player;
     StoryTree story;
     EventManager events;
+    CowPtr<EventTimerWheel> scheduledEvents; // events waiting for a future day
     
-    // Stack for Undo (LIFO)
-    stack<GameSnapshot> historyStack;
+    // Undo history (LIFO), delta-encoded and capped in memory
+    SnapshotHistory history;
     
     // Queue for Multi-turn actions (FIFO)
     queue<string> actionQueue; 
@@ -199,23 +2866,450 @@ private:
     int currentDay;
     GameState state;
 
+    // Write-ahead log of player actions; journalPosition is the last lsn applied
+    ActionJournal journal;
+    uint64_t journalPosition = 0;
+
+    // Background saves every autosaveEvery days (0 = off). Declared after
+    // the journal so its writer thread, which cuts the journal, stops first.
+    AutosaveWriter autosave;
+    int autosaveEvery = 0;
+
+    // Replay mode (see loadReplay). Checkpoint k is the state before
+    // action k * replayEvery, undo history included so replayed UNDOs match.
+    struct ReplayCheckpoint {
+        GameSnapshot state;
+        SnapshotHistory history;
+    };
+    vector<pair<uint64_t, PlayerAction>> replayActions; // lsn, action
+    vector<ReplayCheckpoint> replayCheckpoints;
+    size_t replayEvery = 0;
+    size_t replayPos = 0; // next action to run
+    bool replaying = false;
+
+    void executeAction(const PlayerAction& action) {
+        switch (action.type) {
+        case ActionType::MOVE_LEFT:
+            saveState();
+            story.moveToLeft();
+            break;
+        case ActionType::MOVE_RIGHT:
+            saveState();
+            story.moveToRight();
+            break;
+        case ActionType::USE_ITEM:
+            saveState();
+            player.inventory.useItem(action.text, &player);
+            break;
+        case ActionType::RECRUIT:
+            saveState();
+            player.recruitMember(textOf(action.text), action.role);
+            break;
+        case ActionType::PROCESS_EVENT:
+            events.processNextEvent(&player);
+            break;
+        case ActionType::END_DAY:
+            advanceDay();
+            break;
+        case ActionType::UNDO:
+            undoLastMove();
+            break;
+        case ActionType::SAVE_POINT:
+            history.clear(); // undo stops at a save, see saveToFile()
+            break;
+        }
+    }
+
 public:
     GameEngine();
     
     // Main Flow
     void initGame();       // Setup tree, stats
     void updateGameLoop(); // Called every frame by ImGui
+
+    // Ends the day; events scheduled for the new day join the event queue,
+    // and one random event is drawn from the template table (if it has
+    // any). Drawing here, inside the journaled END_DAY action, keeps every
+    // use of the world RNG reproducible by replay and recovery. Autosaves
+    // are taken by applyAction() after a journaled END_DAY.
+    void advanceDay() {
+        ++currentDay;
+        scheduledEvents.write().advanceTo(currentDay, events);
+        events.triggerRandomEvent(player);
+    }
+
+    // Saves to path on a background thread every everyDays days; 0 turns it
+    // off. Once a save lands, the writer thread also cuts the journal, so
+    // the game thread never waits on that rewrite.
+    void enableAutosave(const string& path, int everyDays) {
+        autosaveEvery = max(everyDays, 0);
+        if (autosaveEvery > 0) autosave.start(path, [this](uint64_t position) { journal.cutThrough(position); });
+        else autosave.stop();
+    }
+
+    // Random events drawn at the end of each day (see
+    // EventManager::addEventTemplate). Part of the world setup: a replay or
+    // recovery must register the same templates.
+    void addEventTemplate(string_view title, string_view desc, int priority,
+                          double baseWeight, double hungerWeight = 0, double reputationWeight = 0) {
+        events.addEventTemplate(title, desc, priority, baseWeight, hungerWeight, reputationWeight);
+    }
+
+    // Queues an event to fire daysAhead days from now (minimum one)
+    void scheduleEvent(string_view title, string_view desc, int priority, int daysAhead) {
+        EventTimerWheel& wheel = scheduledEvents.write();
+        wheel.advanceTo(currentDay, events);
+        GameEvent event{interner().intern(title), interner().intern(desc), priority, 0};
+        wheel.schedule(event, daysAhead);
+    }
     
     // State Management
-    void saveState();      // Push to stack
-    void undoLastMove();   // Pop from stack
+    // Full state for undo; O(1) to take, see GameSnapshot
+    GameSnapshot captureSnapshot() const {
+        return GameSnapshot{currentDay, player.health, player.hunger, player.energy, player.reputation,
+                            story.currentNodeId(), player.inventory, player.pack, events.captureQueue(),
+                            scheduledEvents, journalPosition};
+    }
+    void restoreSnapshot(const GameSnapshot& s) {
+        currentDay = s.day;
+        player.health = s.health;
+        player.hunger = s.hunger;
+        player.energy = s.energy;
+        player.reputation = s.reputation;
+        story.setCurrentNode(s.currentNodeID);
+        player.inventory = s.inventory;
+        player.pack = s.pack;
+        events.restoreQueue(s.events);
+        scheduledEvents = s.scheduledEvents;
+    }
+
+    void saveState() { history.push(captureSnapshot()); } // Push to history
+    void undoLastMove() {                                  // Pop from history
+        GameSnapshot previous;
+        if (history.pop(previous)) restoreSnapshot(previous);
+    }
+    void setHistoryLimit(size_t bytes) { history.setMemoryCap(bytes); }
     
-    // File I/O
-    void saveToFile(string filename);
-    void loadFromFile(string filename);
+    // File I/O (.wsav, see encodeSave). Undo history is not saved, so every
+    // save (this and autosaves) is an undo barrier: a journaled SAVE_POINT
+    // clears the history first, and live play, recovery and replay all see
+    // the same barrier. A successful save also cuts the journal, so
+    // recover() must be given the newest save.
+    bool saveToFile(const string& filename) {
+        applyAction(PlayerAction{ActionType::SAVE_POINT});
+        if (!writeFileAtomically(filename, encodeSave(captureSnapshot()))) return false;
+        journal.commit();
+        journal.cutThrough(journalPosition);
+        return true;
+    }
+    bool loadFromFile(const string& filename) {
+        MappedFile file;
+        if (!file.open(filename)) return false;
+        GameSnapshot s = captureSnapshot();
+        if (!decodeSave(file.data(), file.size(), s)) return false;
+        restoreSnapshot(s);
+        history.clear(); // undo history is not saved; it must not reach past the load
+        journalPosition = s.journalPosition;
+        autosave.flush();  // its journal cut belongs to the session being replaced
+        journal.restart(); // play continues from the save
+        return true;
+    }
+
+    // Player decisions. Each is journaled (when a journal is open) before it
+    // runs; call endTurn() once per turn to make the turn's records durable.
+    // An END_DAY that reaches an autosave day also journals its SAVE_POINT
+    // and hands the save to the writer thread.
+    void applyAction(const PlayerAction& action) {
+        ++journalPosition;
+        journal.append(journalPosition, action);
+        executeAction(action);
+        if (action.type == ActionType::END_DAY && autosaveEvery > 0 && currentDay % autosaveEvery == 0) {
+            applyAction(PlayerAction{ActionType::SAVE_POINT});
+            autosave.requestSave(captureSnapshot());
+        }
+    }
+    bool endTurn() { return journal.commit(); }
+
+    // Journals actions to path from now on, starting a new journal there
+    bool enableJournal(const string& path) {
+        autosave.flush(); // a pending cut must not land on the new journal
+        return journal.open(path);
+    }
+
+    // Crash recovery: loads the last save (if any), replays the journal
+    // records made after it and keeps journaling to journalPath. false only
+    // when the journal cannot be reopened. Saves are undo barriers (see
+    // saveToFile), so the recovered undo history matches the live one.
+    bool recover(const string& savePath, const string& journalPath) {
+        journal.close();
+        loadFromFile(savePath);
+        size_t valid = ActionJournal::read(journalPath, [this](uint64_t lsn, const PlayerAction& action) {
+            if (lsn <= journalPosition) return;
+            journalPosition = lsn;
+            executeAction(action);
+        });
+        return journal.open(journalPath, valid);
+    }
+
+    // Replay mode: re-runs a recorded session (a save, then the journal
+    // written after it) headless, with nothing journaled or autosaved. The
+    // whole state is kept every checkpointEvery actions as it goes, so a
+    // seek runs at most that many actions from the nearest checkpoint.
+    // false when there is nothing to replay.
+    bool loadReplay(const string& savePath, const string& journalPath, size_t checkpointEvery = 256) {
+        journal.close();
+        bool loaded = loadFromFile(savePath);
+        replayActions.clear();
+        ActionJournal::read(journalPath, [this](uint64_t lsn, const PlayerAction& action) {
+            if (lsn > journalPosition) replayActions.push_back({lsn, action});
+        });
+        replayCheckpoints.clear();
+        replayCheckpoints.push_back(ReplayCheckpoint{captureSnapshot(), history});
+        replayEvery = max<size_t>(checkpointEvery, 1);
+        replayPos = 0;
+        replaying = true;
+        return loaded || !replayActions.empty();
+    }
+
+    // Runs the next recorded action; false at the end
+    bool stepReplay() {
+        if (!replaying || replayPos >= replayActions.size()) return false;
+        journalPosition = replayActions[replayPos].first;
+        executeAction(replayActions[replayPos].second);
+        ++replayPos;
+        if (replayPos % replayEvery == 0 && replayPos / replayEvery == replayCheckpoints.size())
+            replayCheckpoints.push_back(ReplayCheckpoint{captureSnapshot(), history});
+        return true;
+    }
+
+    // Moves to the state just before recorded action `position` (clamped
+    // to the end), backwards or forwards
+    void seekReplay(size_t position) {
+        if (!replaying) return;
+        position = min(position, replayActions.size());
+        size_t k = min(position / replayEvery, replayCheckpoints.size() - 1);
+        if (position < replayPos || k * replayEvery > replayPos) {
+            const ReplayCheckpoint& checkpoint = replayCheckpoints[k];
+            restoreSnapshot(checkpoint.state);
+            history = checkpoint.history;
+            journalPosition = checkpoint.state.journalPosition;
+            replayPos = k * replayEvery;
+        }
+        while (replayPos < position) stepReplay();
+    }
+    void replayToEnd() { seekReplay(replayActions.size()); }
+
+    // Leaves replay mode in the replayed state; journaling stays off until
+    // enableJournal()
+    void endReplay() {
+        replaying = false;
+        replayActions.clear();
+        replayCheckpoints.clear();
+    }
+
+    bool isReplaying() const { return replaying; }
+    size_t replayLength() const { return replayActions.size(); }
+    size_t replayPosition() const { return replayPos; }
 
     // Getters for GUI
     Wolf* getPlayer() { return &player; }
     StoryTree* getStory() { return &story; }
     int getDay() { return currentDay; }
-};
\ No newline at end of file
+    bool hasPendingEvents() const { return events.hasPendingEvents(); }
+
+    // All randomness in a world comes from this seed
+    void seedWorld(uint64_t seed) { events.seedRandom(seed); }
+};
+
+// 11. Headless Batch Simulation
+// Plays many independent games without rendering, for balancing content.
+// Each run builds its own GameEngine, seeded from the batch seed and the
+// run number, and feeds it actions from a policy until it reaches an
+// ending, the wolf dies, the policy stops or maxActions is hit.
+//
+// Runs are spread over a work-stealing pool: every worker owns a range of
+// run numbers and takes `grain` runs at a time from its front; a worker
+// that runs dry steals the back half of another's range. Workers keep
+// their own stats and interner (see InternerScope), so nothing is shared
+// while running and throughput scales with cores.
+
+// Picks the next action; false ends the run. Runs on a worker thread:
+// TextIds it puts in the action must come from interner() there.
+using SimPolicy = function<bool(GameEngine&, WorldRng&, PlayerAction&)>;
+
+// One step of a scripted policy. The text is kept as a string, not a
+// TextId, because runs intern into their worker's interner.
+struct ScriptedAction {
+    ActionType type;
+    string text;            // item (USE_ITEM) or member name (RECRUIT)
+    Role role = Role::NONE; // RECRUIT only
+};
+
+// Plays `script` once, in order
+inline SimPolicy scriptedPolicy(vector<ScriptedAction> script) {
+    size_t next = 0;
+    return [script, next](GameEngine&, WorldRng&, PlayerAction& action) mutable {
+        if (next >= script.size()) return false;
+        const ScriptedAction& step = script[next++];
+        action = PlayerAction{step.type, step.text.empty() ? NO_TEXT : interner().intern(step.text), step.role};
+        return true;
+    };
+}
+
+// Handles pending events first, otherwise mostly picks a random branch,
+// sometimes using a random item or ending the day
+inline SimPolicy randomPolicy() {
+    return [](GameEngine& game, WorldRng& rng, PlayerAction& action) {
+        const Inventory& inventory = game.getPlayer()->inventory;
+        uint32_t roll = rng.below(10);
+        if (game.hasPendingEvents())
+            action = PlayerAction{ActionType::PROCESS_EVENT};
+        else if (roll == 0 && inventory.size() > 0)
+            action = PlayerAction{ActionType::USE_ITEM, inventory.begin()[rng.below(uint32_t(inventory.size()))].name};
+        else if (roll == 1)
+            action = PlayerAction{ActionType::END_DAY};
+        else
+            action = PlayerAction{roll % 2 ? ActionType::MOVE_LEFT : ActionType::MOVE_RIGHT};
+        return true;
+    };
+}
+
+struct BatchConfig {
+    uint64_t runs = 0;
+    uint64_t seed = 0;
+    size_t maxActions = 10000; // per run
+    unsigned threads = 0;      // 0 = one per core
+    uint64_t grain = 64;       // runs taken from the own range at a time
+};
+
+struct BatchStats {
+    uint64_t runs = 0;
+    uint64_t died = 0;                     // health reached 0
+    uint64_t unfinished = 0;               // no ending before the policy or maxActions stopped
+    uint64_t totalDays = 0;                // days survived, summed over runs
+    unordered_map<int, uint64_t> endings;  // ending node id -> runs that reached it
+
+    double averageDays() const { return runs ? double(totalDays) / double(runs) : 0.0; }
+
+    void merge(const BatchStats& other) {
+        runs += other.runs;
+        died += other.died;
+        unfinished += other.unfinished;
+        totalDays += other.totalDays;
+        for (const auto& ending : other.endings) endings[ending.first] += ending.second;
+    }
+};
+
+class BatchSimulator {
+public:
+    // Builds run `run`'s world (story, stats, items) into a fresh engine;
+    // called on a worker thread, so it must pass texts as strings, never
+    // TextIds from the caller's thread (see InternerScope). A story file
+    // loaded once and shared as a shared_ptr<const MappedFile> keeps this
+    // cheap.
+    using Setup = function<void(GameEngine&, uint64_t run)>;
+
+private:
+    Setup setup;
+    SimPolicy policy;
+
+    struct RunRange { // runs [begin, end) left to a worker
+        mutex lock;
+        uint64_t begin = 0, end = 0;
+    };
+
+    static bool takeOwn(RunRange& own, uint64_t grain, uint64_t& from, uint64_t& to) {
+        lock_guard<mutex> guard(own.lock);
+        if (own.begin == own.end) return false;
+        from = own.begin;
+        to = own.begin + min(grain, own.end - own.begin);
+        own.begin = to;
+        return true;
+    }
+
+    static bool steal(RunRange& victim, RunRange& own) {
+        uint64_t from, to;
+        {
+            lock_guard<mutex> guard(victim.lock);
+            if (victim.begin == victim.end) return false;
+            from = victim.begin + (victim.end - victim.begin) / 2;
+            to = victim.end;
+            victim.end = from;
+        }
+        lock_guard<mutex> guard(own.lock);
+        own.begin = from;
+        own.end = to;
+        return true;
+    }
+
+    void playRun(uint64_t run, const BatchConfig& config, BatchStats& stats) const {
+        uint64_t runSeed = config.seed ^ (0x9E3779B97F4A7C15ull * (run + 1));
+        GameEngine game;
+        setup(game, run);
+        game.seedWorld(runSeed);
+        WorldRng choices(~runSeed);
+        SimPolicy play = policy; // scripted policies keep their position per run
+
+        bool ended = false, died = false;
+        PlayerAction action{ActionType::END_DAY};
+        for (size_t n = 0; n < config.maxActions && play(game, choices, action); n++) {
+            game.applyAction(action);
+            if (game.getPlayer()->health <= 0) {
+                died = true;
+                break;
+            }
+            if (game.getStory()->isAtEnding()) {
+                ended = true;
+                break;
+            }
+        }
+
+        stats.runs++;
+        stats.totalDays += uint64_t(max(game.getDay(), 0));
+        if (died) stats.died++;
+        else if (ended) stats.endings[game.getStory()->currentNodeId()]++;
+        else stats.unfinished++;
+    }
+
+    void work(size_t self, vector<RunRange>& ranges, const BatchConfig& config, BatchStats& stats) const {
+        StringInterner texts;
+        InternerScope scope(texts);
+        RunRange& own = ranges[self];
+        uint64_t grain = max<uint64_t>(config.grain, 1);
+        for (;;) {
+            uint64_t from, to;
+            if (takeOwn(own, grain, from, to)) {
+                for (uint64_t run = from; run < to; run++) playRun(run, config, stats);
+                continue;
+            }
+            bool stole = false; // ranges only shrink, so all empty means done
+            for (size_t i = 1; i < ranges.size() && !stole; i++) stole = steal(ranges[(self + i) % ranges.size()], own);
+            if (!stole) return;
+        }
+    }
+
+public:
+    BatchSimulator(Setup setupRun, SimPolicy choose) : setup(move(setupRun)), policy(move(choose)) {}
+
+    BatchStats run(const BatchConfig& config) const {
+        unsigned threads = config.threads ? config.threads : max(thread::hardware_concurrency(), 1u);
+        threads = unsigned(max<uint64_t>(min<uint64_t>(threads, config.runs), 1));
+
+        vector<RunRange> ranges(threads);
+        for (unsigned t = 0; t < threads; t++) {
+            ranges[t].begin = config.runs * t / threads;
+            ranges[t].end = config.runs * (t + 1) / threads;
+        }
+
+        vector<BatchStats> perWorker(threads);
+        vector<thread> workers;
+        for (unsigned t = 1; t < threads; t++)
+            workers.emplace_back(&BatchSimulator::work, this, size_t(t), ref(ranges), cref(config), ref(perWorker[t]));
+        work(0, ranges, config, perWorker[0]);
+        for (thread& worker : workers) worker.join();
+
+        BatchStats total;
+        for (const BatchStats& stats : perWorker) total.merge(stats);
+        return total;
+    }
+};
@@ -0,0 +1,395 @@
+// Standalone benchmarks for the engine's data structures: save-load
+// latency against story size, interned-text memory on a 1M-node story,
+// inventory operations, heap vs bucket event queues, RNG and random-event
+// rate, undo history bytes per turn, and save/load latency against a text
+// format. Links against the test stubs; build optimized from the repo root:
+//
+//     g++ -std=c++17 -O2 -pthread bench/bench.cpp -o wolf_bench && ./wolf_bench
+//
+// Numbers are wall-clock on whatever machine runs it; compare runs on the
+// same machine only.
+#include "../tests/stubs.h"
+
+#include <chrono>
+#include <fstream>
+#include <unistd.h>
+
+using BenchClock = chrono::steady_clock;
+
+static double secondsSince(BenchClock::time_point start) {
+    return chrono::duration<double>(BenchClock::now() - start).count();
+}
+
+// Keeps the optimizer from dropping a result
+static volatile uint64_t sink;
+
+// Story shape for buildTree(): a complete binary tree of benchTreeSize
+// nodes, node i having children 2i and 2i+1, with choice labels drawn from
+// a small set and scenarios repeating every 1000 nodes, as generated
+// campaigns do
+static int benchTreeSize = 1;
+static const char* const CHOICES[] = {"Fight", "Flee", "Hide", "Howl", "Follow the scent", "Circle around",
+                                      "Wait for the pack", "Cross the river"};
+
+static string scenarioText(int id) { return "The trail bends again; the forest here is marked " + to_string(id % 1000) + "."; }
+
+void StoryTree::buildTree() {
+    vector<StoryNode*> nodes(size_t(benchTreeSize) + 1, nullptr);
+    for (int id = 1; id <= benchTreeSize; id++) {
+        StoryNode* node = createNode(id, scenarioText(id));
+        bool leaf = id * 2 > benchTreeSize;
+        if (leaf) {
+            node->isEnding = true;
+            node->endingDescription = interner().intern("The hunt ends in the valley.");
+        } else {
+            node->choiceAText = interner().intern(CHOICES[id % 8]);
+            node->choiceBText = interner().intern(CHOICES[(id / 8) % 8]);
+        }
+        nodes[size_t(id)] = node;
+        if (id > 1) (id % 2 ? nodes[size_t(id / 2)]->right : nodes[size_t(id / 2)]->left) = node;
+    }
+    root = nodes[1];
+    currentScenario = root;
+}
+
+// Loading a save resolves the saved node id through nodeIndex;
+// the old recursive findNode walked the tree for it
+static void benchLoadLatency(const string& savePath) {
+    printf("\nSave load latency vs story size (current node = last id)\n");
+    printf("%10s %16s %22s\n", "nodes", "load (us)", "tree walk lookup (us)");
+    for (int size : {1000, 10000, 100000, 1000000}) {
+        benchTreeSize = size;
+        GameEngine game;
+        game.getStory()->buildTree();
+        game.getStory()->setCurrentNode(size);
+        CHECK(game.saveToFile(savePath));
+
+        const int reps = 200;
+        auto start = BenchClock::now();
+        for (int i = 0; i < reps; i++) CHECK(game.loadFromFile(savePath));
+        double load = secondsSince(start) / reps * 1e6;
+        CHECK(game.getStory()->currentNodeId() == size);
+
+        start = BenchClock::now();
+        for (int i = 0; i < 5; i++) {
+            StoryNode* found = nullptr;
+            game.getStory()->visitNodes([&](StoryNode* n) {
+                if (n->id != size) return true;
+                found = n;
+                return false;
+            });
+            sink = sink + uint64_t(found != nullptr);
+        }
+        double walk = secondsSince(start) / 5 * 1e6;
+        printf("%10d %16.1f %22.1f\n", size, load, walk);
+    }
+}
+
+// Every node text goes through the interner; compare with a
+// std::string per text field
+static void benchInternedMemory() {
+    StringInterner texts;
+    InternerScope scope(texts);
+    benchTreeSize = 1000000;
+    uint64_t stringBytes = 0;
+    auto asString = [](size_t length) { return sizeof(string) + (length > 15 ? length + 1 : 0); };
+    {
+        StoryTree story;
+        story.buildTree();
+        story.visitNodes([&](StoryNode* n) {
+            for (TextId id : {n->scenarioText, n->choiceAText, n->choiceBText, n->endingDescription})
+                stringBytes += asString(textOf(id).size());
+        });
+    }
+    uint64_t handleBytes = uint64_t(benchTreeSize) * 4 * sizeof(TextId);
+    uint64_t internedBytes = handleBytes + texts.bytesStored() + texts.count() * (sizeof(string_view) + 2 * sizeof(TextId));
+    printf("\nStory texts on a %d-node tree\n", benchTreeSize);
+    printf("  std::string per field:  %8.1f MB\n", stringBytes / 1e6);
+    printf("  interned (handles, text, table): %8.1f MB, %zu distinct texts\n", internedBytes / 1e6, texts.count());
+    printf("  saved: %.1f MB\n", (double(stringBytes) - double(internedBytes)) / 1e6);
+}
+
+// The fixed-capacity Inventory against the singly linked list
+// of heap nodes it replaced
+struct ListItem {
+    string name;
+    ItemType type;
+    int effectValue;
+    string description;
+    ListItem* next;
+};
+
+class ListInventory {
+private:
+    ListItem* head = nullptr;
+    int count = 0;
+
+public:
+    ~ListInventory() {
+        while (head) {
+            ListItem* next = head->next;
+            delete head;
+            head = next;
+        }
+    }
+    bool addItem(const string& name, ItemType type, int value, const string& desc) {
+        if (count >= Inventory::MAX_ITEMS) return false;
+        ListItem** tail = &head;
+        while (*tail) tail = &(*tail)->next;
+        *tail = new ListItem{name, type, value, desc, nullptr};
+        ++count;
+        return true;
+    }
+    bool useItem(const string& name, Wolf* player) {
+        for (ListItem** at = &head; *at; at = &(*at)->next) {
+            if ((*at)->name != name) continue;
+            ListItem* item = *at;
+            player->health += item->effectValue;
+            *at = item->next;
+            delete item;
+            --count;
+            return true;
+        }
+        return false;
+    }
+};
+
+static void benchInventory() {
+    vector<string> names;
+    for (int i = 0; i < Inventory::MAX_ITEMS; i++) names.push_back("Dried meat ration no. " + to_string(i));
+    vector<ItemId> ids;
+    for (const string& name : names) ids.push_back(interner().intern(name));
+    const int rounds = 200000;
+    Wolf wolf;
+
+    auto start = BenchClock::now();
+    for (int r = 0; r < rounds; r++) {
+        Inventory inventory;
+        for (const string& name : names) inventory.addItem(name, ItemType::FOOD, 1, "Tough but filling.");
+        for (int i = Inventory::MAX_ITEMS - 1; i >= 0; i--) inventory.useItem(ids[size_t(i)], &wolf);
+    }
+    double fixed = secondsSince(start);
+
+    start = BenchClock::now();
+    for (int r = 0; r < rounds; r++) {
+        ListInventory inventory;
+        for (const string& name : names) inventory.addItem(name, ItemType::FOOD, 1, "Tough but filling.");
+        for (int i = Inventory::MAX_ITEMS - 1; i >= 0; i--) inventory.useItem(names[size_t(i)], &wolf);
+    }
+    double list = secondsSince(start);
+    sink = sink + uint64_t(wolf.health);
+
+    double ops = double(rounds) * 2 * Inventory::MAX_ITEMS;
+    printf("\nInventory, fill to %d then use every item (ns per add/use)\n", Inventory::MAX_ITEMS);
+    printf("  fixed array: %6.1f\n  linked list: %6.1f\n", fixed / ops * 1e9, list / ops * 1e9);
+}
+
+// The same push/pop stream through both queue modes
+static void benchEventQueues() {
+    const int batches = 1000, batch = 1000;
+    printf("\nEvent queue throughput, %d events in batches of %d (M events/s, push + pop)\n", batches * batch, batch);
+    for (QueueMode mode : {QueueMode::HEAP, QueueMode::BUCKETS}) {
+        EventManager manager(mode);
+        Wolf wolf;
+        WorldRng rng(12);
+        auto start = BenchClock::now();
+        for (int b = 0; b < batches; b++) {
+            for (int i = 0; i < batch; i++) manager.addEvent("Scent on the wind", "", 1 + int(rng.below(3)));
+            while (manager.hasPendingEvents()) manager.processNextEvent(&wolf);
+        }
+        double seconds = secondsSince(start);
+        printf("  %-8s %6.2f\n", mode == QueueMode::HEAP ? "heap" : "buckets", batches * batch / seconds / 1e6);
+    }
+}
+
+// Raw draws, then whole random events (alias-table pick + queue)
+static void benchRandom() {
+    WorldRng rng(17);
+    const uint64_t draws = 200000000;
+    auto start = BenchClock::now();
+    uint64_t mix = 0;
+    for (uint64_t i = 0; i < draws; i++) mix ^= rng.next();
+    double seconds = secondsSince(start);
+    sink = sink + mix;
+
+    EventManager manager;
+    for (int i = 0; i < 32; i++) manager.addEventTemplate("Event " + to_string(i), "", 1 + i % 3, 1.0 + i, 0.1, 0.05);
+    Wolf wolf;
+    const int events = 2000000;
+    auto eventStart = BenchClock::now();
+    for (int i = 0; i < events; i++) {
+        manager.triggerRandomEvent(wolf);
+        manager.processNextEvent(&wolf);
+    }
+    double eventSeconds = secondsSince(eventStart);
+    printf("\nRandom numbers\n  WorldRng: %.0f M draws/s\n  random events (32 templates, drawn and handled): %.1f M/s\n",
+           draws / seconds / 1e6, events / eventSeconds / 1e6);
+}
+
+// A million turns of small stat changes, a move now and then,
+// a new day every 5 turns and a pack change every 100
+static void benchHistoryBytes() {
+    const int turns = 1000000;
+    SnapshotHistory unbounded(size_t(1) << 30);
+    SnapshotHistory capped; // default cap
+    Wolf wolf;
+    WorldRng rng(19);
+    GameSnapshot s{};
+    s.health = 100;
+    for (int turn = 0; turn < turns; turn++) {
+        s.health = max(1, min(100, s.health + int(rng.below(7)) - 3));
+        s.hunger = min(100, max(0, s.hunger + int(rng.below(5)) - 2));
+        s.energy = int(rng.below(101));
+        if (turn % 5 == 0) s.day++;
+        if (rng.below(4) == 0) s.currentNodeID = int(rng.below(100000));
+        if (turn % 100 == 0) {
+            wolf.recruitMember("Wolf " + to_string(turn % 40), Role(turn % ROLE_COUNT));
+            s.pack = wolf.pack;
+        }
+        unbounded.push(s);
+        capped.push(s);
+    }
+    printf("\nUndo history over %d turns\n", turns);
+    printf("  uncapped: %.1f bytes per turn (%.1f MB)\n", double(unbounded.bytesUsed()) / turns, unbounded.bytesUsed() / 1e6);
+    printf("  default 64 KiB cap: keeps the last %zu turns\n", capped.size());
+}
+
+// The binary save against a line-per-field text save of the
+// same state
+static void saveText(const GameSnapshot& s, const string& path) {
+    ofstream out(path);
+    out << s.day << ' ' << s.health << ' ' << s.hunger << ' ' << s.energy << ' ' << s.reputation << ' '
+        << s.currentNodeID << '\n';
+    out << s.inventory.size() << '\n';
+    for (const ItemNode* item = s.inventory.begin(); item != s.inventory.begin() + s.inventory.size(); item++)
+        out << textOf(item->name) << '\n' << int(item->type) << ' ' << item->effectValue << '\n' << textOf(item->description) << '\n';
+    const PackRoster& pack = s.pack.read();
+    out << pack.size() << '\n';
+    for (int i = 0; i < pack.size(); i++)
+        out << textOf(pack.member(i).name) << '\n' << int(pack.member(i).role) << ' ' << pack.member(i).loyalty << '\n';
+    vector<GameEvent> events = s.events.queue.read().pending();
+    out << events.size() << '\n';
+    for (const GameEvent& e : events)
+        out << textOf(e.title) << '\n' << textOf(e.description) << '\n' << e.priority << ' ' << e.sequence << '\n';
+}
+
+static bool loadText(const string& path, GameSnapshot& s) {
+    ifstream in(path);
+    string line;
+    int items = 0, members = 0;
+    size_t events = 0;
+    if (!(in >> s.day >> s.health >> s.hunger >> s.energy >> s.reputation >> s.currentNodeID >> items)) return false;
+    getline(in, line);
+    s.inventory = Inventory();
+    for (int i = 0; i < items; i++) {
+        string name, desc;
+        int type = 0, value = 0;
+        getline(in, name);
+        in >> type >> value;
+        getline(in, line);
+        getline(in, desc);
+        s.inventory.addItem(name, ItemType(type), value, desc);
+    }
+    in >> members;
+    getline(in, line);
+    PackRoster& pack = s.pack.write();
+    pack = PackRoster();
+    for (int i = 0; i < members; i++) {
+        string name;
+        int role = 0, loyalty = 0;
+        getline(in, name);
+        in >> role >> loyalty;
+        getline(in, line);
+        pack.add(name, Role(role), loyalty);
+    }
+    in >> events;
+    getline(in, line);
+    for (size_t i = 0; i < events; i++) {
+        string title, desc;
+        int priority = 0;
+        uint64_t sequence = 0;
+        getline(in, title);
+        getline(in, desc);
+        in >> priority >> sequence;
+        getline(in, line);
+        sink = sink + uint64_t(interner().intern(title)) + interner().intern(desc) + uint64_t(priority) + sequence;
+    }
+    return bool(in);
+}
+
+static void saveBinary(const GameSnapshot& s, const string& path) {
+    vector<uint8_t> image = encodeSave(s);
+    FILE* f = fopen(path.c_str(), "wb");
+    CHECK(f && fwrite(image.data(), 1, image.size(), f) == image.size());
+    fclose(f);
+}
+
+static bool loadBinary(const string& path, GameSnapshot& s) {
+    MappedFile file;
+    return file.open(path) && decodeSave(file.data(), file.size(), s);
+}
+
+// Both formats are timed as plain writes and parses of the same state;
+// the durable saveToFile() (fsync + rename) is reported separately
+static void benchSaveLoad(const string& savePath, const string& textPath) {
+    GameEngine game;
+    benchTreeSize = 1000;
+    game.getStory()->buildTree();
+    game.seedWorld(21);
+    game.addEventTemplate("Rain", "A cold night.", 3, 1.0);
+    game.addEventTemplate("Hunters", "Shots in the distance.", 1, 0.5);
+    for (int i = 0; i < Inventory::MAX_ITEMS; i++)
+        game.getPlayer()->inventory.addItem("Herb bundle " + to_string(i), ItemType::HERB, 5, "Eases pain.");
+    for (int i = 0; i < 60; i++) game.getPlayer()->recruitMember("Packmate " + to_string(i), Role(i % ROLE_COUNT));
+    for (int i = 0; i < 5; i++) game.scheduleEvent("Moon rises", "The pack gathers.", 2, 1 + i);
+    for (int i = 0; i < 40; i++) game.applyAction(PlayerAction{ActionType::END_DAY});
+    GameSnapshot state = game.captureSnapshot();
+    GameSnapshot loaded = state;
+
+    const int reps = 2000;
+    auto start = BenchClock::now();
+    for (int i = 0; i < reps; i++) saveBinary(state, savePath);
+    double binarySave = secondsSince(start) / reps;
+    start = BenchClock::now();
+    for (int i = 0; i < reps; i++) CHECK(loadBinary(savePath, loaded));
+    double binaryLoad = secondsSince(start) / reps;
+
+    start = BenchClock::now();
+    for (int i = 0; i < reps; i++) saveText(state, textPath);
+    double textSave = secondsSince(start) / reps;
+    start = BenchClock::now();
+    for (int i = 0; i < reps; i++) CHECK(loadText(textPath, loaded));
+    double textLoad = secondsSince(start) / reps;
+
+    start = BenchClock::now();
+    for (int i = 0; i < 200; i++) CHECK(game.saveToFile(savePath));
+    double durableSave = secondsSince(start) / 200;
+
+    FILE* text = fopen(textPath.c_str(), "rb");
+    CHECK(text && fseek(text, 0, SEEK_END) == 0);
+    long textBytes = ftell(text);
+    fclose(text);
+
+    printf("\nSave / load, %d items, %d pack members, %zu pending events (us per call)\n", state.inventory.size(),
+           state.pack.read().size(), state.events.queue.read().pending().size());
+    printf("  binary .wsav: save %6.1f, load %6.1f, %zu bytes\n", binarySave * 1e6, binaryLoad * 1e6, encodeSave(state).size());
+    printf("  text:         save %6.1f, load %6.1f, %ld bytes\n", textSave * 1e6, textLoad * 1e6, textBytes);
+    printf("  saveToFile (atomic, fsync): %.1f\n", durableSave * 1e6);
+}
+
+int main() {
+    string base = "wolf_bench." + to_string(getpid());
+    string savePath = base + ".wsav", textPath = base + ".txt";
+
+    benchLoadLatency(savePath);
+    benchInternedMemory();
+    benchInventory();
+    benchEventQueues();
+    benchRandom();
+    benchHistoryBytes();
+    benchSaveLoad(savePath, textPath);
+
+    remove(savePath.c_str());
+    remove(textPath.c_str());
+    return 0;
+}
@@ -0,0 +1,55 @@
+// Builds a story that is one long left-chain (10M nodes by default, or
+// argv[1]) through StoryTree's own node creation, walks and indexes it, then
+// destroys the tree, all on a thread with a 256 KiB stack. Any recursion
+// over the depth of the tree overflows that stack.
+//
+//     g++ -std=c++17 -O2 -pthread tests/deep_story_chain.cpp -o deep_story_chain
+#include "stubs.h"
+
+#include <pthread.h>
+
+static int chainLength = 10000000;
+
+// Node 0 is the root; node i+1 is the left child of node i
+void StoryTree::buildTree() {
+    root = createNode(0, "The trail goes on.");
+    StoryNode* tail = root;
+    for (int id = 1; id < chainLength; id++) {
+        tail->left = createNode(id, "The trail goes on.");
+        tail = tail->left;
+    }
+    tail->isEnding = true;
+    currentScenario = root;
+}
+
+static void* playChain(void*) {
+    {
+        StoryTree story;
+        story.buildTree();
+
+        size_t visited = 0;
+        story.visitNodes([&](StoryNode*) { visited++; });
+        CHECK(visited == size_t(chainLength));
+
+        story.setCurrentNode(chainLength - 1);
+        CHECK(story.currentNodeId() == chainLength - 1);
+        CHECK(story.isAtEnding());
+    } // ~StoryTree frees the whole chain here
+    return nullptr;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1) chainLength = atoi(argv[1]);
+    CHECK(chainLength > 0);
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, 256 * 1024);
+    pthread_t thread;
+    CHECK(pthread_create(&thread, &attr, playChain, nullptr) == 0);
+    pthread_join(thread, nullptr);
+    pthread_attr_destroy(&attr);
+
+    printf("deep_story_chain: %d nodes ok\n", chainLength);
+    return 0;
+}
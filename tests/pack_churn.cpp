@@ -0,0 +1,67 @@
+// Recruits and dismisses pack members at random for a long time and checks
+// that, once the roster has reached its working size, churn allocates
+// nothing (dismissal keeps page storage for the next recruit) and the per-role
+// counts and loyalty totals stay consistent with the members.
+//
+//     g++ -std=c++17 -O2 -pthread tests/pack_churn.cpp -o pack_churn
+#define WOLF_COUNT_ALLOCATIONS
+#include "stubs.h"
+
+static const int NAMES = 256;
+static const int MAX_PACK = 200;
+
+static void checkRoster(const PackRoster& pack) {
+    int counted = 0;
+    for (int r = 0; r < ROLE_COUNT; r++) {
+        Role role = Role(r);
+        int total = 0;
+        pack.membersWith(role).forEach([&](uint32_t i) {
+            CHECK(pack.member(int(i)).role == role);
+            total += pack.member(int(i)).loyalty;
+        });
+        CHECK(total == pack.totalLoyalty(role));
+        counted += pack.countOf(role);
+    }
+    CHECK(counted == pack.size());
+}
+
+// One random recruit or dismissal
+static void churn(Wolf& wolf, WorldRng& rng, const vector<string>& names) {
+    int size = wolf.pack.read().size();
+    if (size == 0 || (size < MAX_PACK && rng.below(2) == 0)) {
+        wolf.recruitMember(names[rng.below(NAMES)], Role(rng.below(ROLE_COUNT)));
+    } else {
+        TextId name = wolf.pack.read().member(int(rng.below(uint32_t(size)))).name;
+        CHECK(wolf.dismissMember(textOf(name)));
+    }
+}
+
+int main() {
+    vector<string> names;
+    for (int i = 0; i < NAMES; i++) {
+        names.push_back("Packmate number " + to_string(i));
+        interner().intern(names.back()); // names are known before play starts
+    }
+
+    // Warm-up: every column, each role bucket included, reaches the largest
+    // size the churn below can give it, then random churn
+    Wolf wolf;
+    for (int r = 0; r < ROLE_COUNT; r++) {
+        for (int i = 0; i < MAX_PACK; i++) wolf.recruitMember(names[i], Role(r));
+        for (int i = 0; i < MAX_PACK; i++) CHECK(wolf.dismissMember(names[i]));
+    }
+    WorldRng rng(42);
+    for (int step = 0; step < 100000; step++) churn(wolf, rng, names);
+    checkRoster(wolf.pack.read());
+
+    size_t allocations = 0;
+    for (int round = 0; round < 100; round++) {
+        AllocationScope scope;
+        for (int step = 0; step < 10000; step++) churn(wolf, rng, names);
+        allocations += scope.count();
+        checkRoster(wolf.pack.read());
+    }
+    printf("pack_churn: %zu allocations in 1M recruits/dismissals after warm-up\n", allocations);
+    CHECK(allocations == 0);
+    return 0;
+}
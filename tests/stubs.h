@@ -0,0 +1,41 @@
+// Test support: pulls in StructCode.cpp and gives minimal bodies to the
+// members it declares but leaves to the game's UI translation unit, so a
+// test links on its own. Tests build standalone from the repo root, e.g.
+//
+//     g++ -std=c++17 -O2 -pthread tests/deep_story_chain.cpp -o deep_story_chain
+//
+// StoryTree::buildTree() is left out; a test that needs a tree defines it.
+#pragma once
+
+#include "../StructCode.cpp"
+
+#include <cstdio>
+#include <cstdlib>
+
+// Fails the test with the condition text (not compiled out by NDEBUG)
+#define CHECK(cond)                                                              \
+    do {                                                                         \
+        if (!(cond)) {                                                           \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+            exit(1);                                                             \
+        }                                                                        \
+    } while (0)
+
+Wolf::Wolf() : health(100), hunger(0), energy(100), reputation(0) {}
+
+void Wolf::recruitMember(string_view name, Role role) { pack.write().add(name, role, 50); }
+
+bool Inventory::useItem(ItemId id, Wolf* player) {
+    int slot = findSlot(id);
+    if (slot < 0) return false;
+    player->health += items[slot].effectValue;
+    removeItem(id);
+    return true;
+}
+
+void EventManager::applyEvent(const GameEvent& event, Wolf* player) { player->health -= event.priority; }
+
+StoryTree::StoryTree(StoryStorage mode) : root(nullptr), currentScenario(nullptr), storage(mode) {}
+StoryTree::~StoryTree() { deleteTree(root); }
+
+GameEngine::GameEngine() : currentDay(0), state(GameState::PLAYING) {}
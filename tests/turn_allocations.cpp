@@ -0,0 +1,45 @@
+// Plays journaled turns with the allocation counter on and checks that,
+// once buffers have reached their working size, a whole turn (the day's
+// random events, handling them, the end of the day and the journal
+// commit) performs no heap allocation at all.
+//
+//     g++ -std=c++17 -O2 -pthread tests/turn_allocations.cpp -o turn_allocations
+#define WOLF_COUNT_ALLOCATIONS
+#include "stubs.h"
+
+#include <unistd.h>
+
+static void playTurn(GameEngine& game) {
+    game.applyAction(PlayerAction{ActionType::END_DAY});
+    while (game.hasPendingEvents()) game.applyAction(PlayerAction{ActionType::PROCESS_EVENT});
+    CHECK(game.endTurn());
+}
+
+// Worst allocation count over `turns` turns, after a warm-up
+static size_t worstTurn(GameEngine& game, int turns) {
+    for (int turn = 0; turn < 1000; turn++) playTurn(game);
+    size_t worst = 0;
+    for (int turn = 0; turn < turns; turn++) {
+        AllocationScope scope;
+        playTurn(game);
+        worst = max(worst, scope.count());
+    }
+    return worst;
+}
+
+int main() {
+    string journalPath = "turn_allocations." + to_string(getpid()) + ".wjnl";
+    {
+        GameEngine game;
+        game.seedWorld(7);
+        game.addEventTemplate("Rain", "A cold night.", 3, 1.0);
+        game.addEventTemplate("Hunters", "Shots in the distance.", 2, 0.5);
+        CHECK(game.enableJournal(journalPath));
+
+        size_t worst = worstTurn(game, 500);
+        printf("turn_allocations: %zu allocations in the worst journaled turn\n", worst);
+        CHECK(worst == 0);
+    }
+    remove(journalPath.c_str());
+    return 0;
+}